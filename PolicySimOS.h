@@ -0,0 +1,179 @@
+// Alan Tuecci
+#ifndef POLICYSIMOS_H
+#define POLICYSIMOS_H
+#include "SimOS.h"
+
+/*
+    The simulator with its CPU scheduling, page replacement and disk scheduling policies chosen at compile time.
+    Timer interrupts, memory accesses and disk job completions call the policies directly, so their decisions are inlined into the hot paths.
+    Everything else behaves exactly like SimOS, which is the same simulator with RoundRobinScheduling, LRUReplacement and FCFSDiskScheduling.
+    Use DynamicScheduling, DynamicReplacement and DynamicDiskScheduling to choose policies at run time instead.
+*/
+template <class Scheduler, class Replacement, class DiskPolicy>
+class PolicySimOS : private SimOS
+{
+public:
+    PolicySimOS(int numberOfDisks, unsigned long long amountOfRAM, unsigned int pageSize,
+                const Scheduler& scheduler = Scheduler(), const Replacement& replacement = Replacement(), const DiskPolicy& diskPolicy = DiskPolicy()):
+        SimOS(numberOfDisks, amountOfRAM, pageSize),
+        scheduler_{scheduler},
+        replacement_{replacement},
+        diskPolicy_{diskPolicy}
+    {
+    }
+
+    /*
+        @param  A simulation to continue from, such as a warmed-up SimOS or one of its clones.
+        @post   The simulation continues from that state with these policies. The state is shared with the original until either side changes it.
+    */
+    explicit PolicySimOS(const SimOS& state, const Scheduler& scheduler = Scheduler(), const Replacement& replacement = Replacement(), const DiskPolicy& diskPolicy = DiskPolicy()):
+        SimOS(state),
+        scheduler_{scheduler},
+        replacement_{replacement},
+        diskPolicy_{diskPolicy}
+    {
+    }
+
+    /*
+        @return An independent copy of the simulation and its policies, sharing state like SimOS::Clone().
+    */
+    PolicySimOS Clone() const { return *this; }
+
+    using SimOS::NewProcess;
+    using SimOS::SimFork;
+    using SimOS::NewProcesses;
+    using SimOS::SimForkN;
+    using SimOS::NewThread;
+    using SimOS::GetThreads;
+    using SimOS::CreateSharedMemory;
+    using SimOS::AttachSharedMemory;
+    using SimOS::DetachSharedMemory;
+    using SimOS::CreateMessageQueue;
+    using SimOS::SendMessage;
+    using SimOS::ReceiveMessage;
+    using SimOS::GetMessageQueueStats;
+    using SimOS::SimExit;
+    using SimOS::SimWait;
+    using SimOS::GetCPU;
+    using SimOS::GetReadyQueue;
+    using SimOS::GetMemory;
+    using SimOS::InternFileName;
+    using SimOS::GetDisk;
+    using SimOS::GetDiskQueue;
+    using SimOS::GetDiskSeekStats;
+    using SimOS::SetDiskServiceModel;
+    using SimOS::GetDiskReport;
+    using SimOS::SetDiskParallelism;
+    using SimOS::CreateVolume;
+    using SimOS::VolumeReadRequest;
+    using SimOS::FailVolumeDisk;
+    using SimOS::GetVolumeStats;
+    using SimOS::CreateReplicaSet;
+    using SimOS::GetReplicaSetStats;
+    using SimOS::CreateFile;
+    using SimOS::DeleteFile;
+    using SimOS::GetFileExtents;
+    using SimOS::ReadFile;
+    using SimOS::GetFileSystemStats;
+    using SimOS::SetFileCache;
+    using SimOS::GetFileCacheStats;
+    using SimOS::GetSchedulingStats;
+    using SimOS::GetProcessMetrics;
+    using SimOS::SetTimeQuantum;
+    using SimOS::SetContextSwitchCost;
+    using SimOS::GetContextSwitchReport;
+    using SimOS::GetRealTimeReport;
+    using SimOS::SetProcessIDRecycling;
+    using SimOS::SaveCheckpoint;
+    using SimOS::LoadCheckpoint;
+
+    /*
+        @post   Same as SimOS::TimerInterrupt(), with the scheduling policy deciding whether the running process is preempted.
+    */
+    void TimerInterrupt() { timerInterruptWith(scheduler_); }
+
+    /*
+        @param  The number of timer interrupts to apply.
+        @post   Same as SimOS::TimerInterrupt(count), with the scheduling policy deciding whether the running process is preempted.
+    */
+    void TimerInterrupt(unsigned long long count) { timerInterruptsWith(scheduler_, count); }
+
+    /*
+        @param  The number of the disk.
+        @post   Same as SimOS::DiskJobCompleted(diskNumber), with the disk scheduling policy choosing the request served next.
+    */
+    void DiskJobCompleted(int diskNumber) { diskJobCompletedWith(diskPolicy_, diskNumber); }
+
+    /*
+        @param  The number of the disk.
+        @param  The in-flight slot whose job completed.
+        @post   Same as SimOS::DiskJobCompleted(diskNumber, slot), with the disk scheduling policy choosing the request the slot serves next.
+    */
+    void DiskJobCompleted(int diskNumber, unsigned int slot) { diskJobCompletedWith(diskPolicy_, diskNumber, slot); }
+
+    /*
+        @param  The number of the disk that contains the file to be read.
+        @param  The name of the file to be read.
+        @post   Same as SimOS::DiskReadRequest(diskNumber, fileName), with the page replacement policy deciding how a file block cache hit is recorded.
+    */
+    void DiskReadRequest(int diskNumber, const std::string& fileName) { diskReadRequestWith(replacement_, diskNumber, InternFileName(fileName), 0); }
+
+    /*
+        @param  The number of the disk that contains the file to be read.
+        @param  The name of the file to be read.
+        @param  The cylinder the file is on.
+        @post   Same as SimOS::DiskReadRequest(diskNumber, fileName, cylinder), with the page replacement policy deciding how a file block cache hit is recorded.
+    */
+    void DiskReadRequest(int diskNumber, const std::string& fileName, unsigned long long cylinder) { diskReadRequestWith(replacement_, diskNumber, InternFileName(fileName), cylinder); }
+
+    /*
+        @param  The number of the disk that contains the file to be read.
+        @param  The ID of the name of the file to be read, from InternFileName().
+        @param  The cylinder the file is on.
+        @post   Same as SimOS::DiskReadRequest(diskNumber, fileNameID, cylinder), with the page replacement policy deciding how a file block cache hit is recorded.
+    */
+    void DiskReadRequest(int diskNumber, int fileNameID, unsigned long long cylinder) { diskReadRequestWith(replacement_, diskNumber, fileNameID, cylinder); }
+
+    /*
+        @param  The number of the replica set that holds the file.
+        @param  The name of the file to be read.
+        @param  The cylinder the file is on.
+        @post   Same as SimOS::ReplicaReadRequest(replicaSetNumber, fileName, cylinder), with the page replacement policy deciding how a file block cache hit is recorded.
+        @return The number of the disk the read was placed on.
+    */
+    int ReplicaReadRequest(int replicaSetNumber, const std::string& fileName, unsigned long long cylinder) { return replicaReadRequestWith(replacement_, replicaSetNumber, InternFileName(fileName), cylinder); }
+
+    /*
+        @param  The number of the replica set that holds the file.
+        @param  The ID of the name of the file to be read, from InternFileName().
+        @param  The cylinder the file is on.
+        @post   Same as SimOS::ReplicaReadRequest(replicaSetNumber, fileNameID, cylinder), with the page replacement policy deciding how a file block cache hit is recorded.
+        @return The number of the disk the read was placed on.
+    */
+    int ReplicaReadRequest(int replicaSetNumber, int fileNameID, unsigned long long cylinder) { return replicaReadRequestWith(replacement_, replicaSetNumber, fileNameID, cylinder); }
+
+    /*
+        @param  The reads to submit, in order.
+        @post   Same as SimOS::SubmitDiskReads(submissions), with the page replacement policy deciding how a file block cache hit is recorded.
+        @return The number of submissions made.
+    */
+    unsigned int SubmitDiskReads(const std::vector<DiskSubmission>& submissions) { return submitDiskReadsWith(replacement_, submissions); }
+
+    /*
+        @param  The disks that completed a job, one entry per completion, in order.
+        @post   Same as SimOS::CompleteDiskJobs(diskNumbers), with the disk scheduling policy choosing the requests served next.
+        @return The finished requests, in order.
+    */
+    std::vector<DiskCompletion> CompleteDiskJobs(const std::vector<int>& diskNumbers) { return completeDiskJobsWith(diskPolicy_, diskNumbers); }
+
+    /*
+        @param  The logical address in RAM.
+        @post   Same as SimOS::AccessMemoryAddress(address), with the page replacement policy deciding how a hit is recorded.
+    */
+    void AccessMemoryAddress(unsigned long long address) { accessMemoryAddressWith(replacement_, address); }
+private:
+    Scheduler scheduler_;
+    Replacement replacement_;
+    DiskPolicy diskPolicy_;
+};
+#endif
@@ -8,18 +8,16 @@
     @post   Disks, frame, and page enumerations all start from 0
 */
 SimOS::SimOS(int numberOfDisks, unsigned long long amountOfRAM, unsigned int pageSize) : 
-    ram_{amountOfRAM, pageSize},
     cpu_{},
-    allProcesses_{},
-    waitingProcesses_{}
+    ram_{MemoryManager{amountOfRAM, pageSize}},
+    processes_{}
 {
     for (int i = 0; i < numberOfDisks; i++)
     {
-        DiskManager disk;
+        CopyOnWrite<DiskManager> disk;
         disks_.push_back(disk);
+        fileSystems_.push_back(CopyOnWrite<FileSystem>{});
     }
-    Process OS_PROCESS(0, NO_PROCESS);
-    allProcesses_.push_back(OS_PROCESS);
 }
 
 /*
@@ -27,31 +25,125 @@ SimOS::SimOS(int numberOfDisks, unsigned long long amountOfRAM, unsigned int pag
             The new process takes place in the ready-queue or immediately starts using the CPU.
             Every process in the simulated system has a PID.
             The simulation assigns PIDs to new processes starting from 1 and incrememnts it by one for each new process.
-            The PIDs of terminated processes will NOT be reused.
+            The PIDs of terminated processes will NOT be reused, and PIDs stay sequential up to MAX_PROCESS_SLOTS - 1 (2^30 - 1).
+            With SetProcessIDRecycling(true), the process table slots of terminated processes are reused under new, still unique, PIDs.
 */
 void SimOS::NewProcess()
 {
-    Process newProcess(allProcesses_.size(), NEW);
-    newProcess.setProcessState(cpu_.addProcess(newProcess.getProcessID()));
-    allProcesses_.push_back(newProcess);
+    int processID = processes_.create(NEW);
+    cpu_.write().recordArrival(processID);
+    processes_.setProcessState(processID, cpu_.write().addProcess(processID));
+}
+
+/*
+    @param  The time between the releases of the process's jobs.
+    @param  The time after its release by which each job must finish.
+    @param  The CPU time each job needs.
+    @post   Creates a new real-time process, scheduled earliest-deadline-first ahead of all other processes, if it passes admission control.
+            Its first job is released immediately. When a job has used its budget, the process sleeps (WAITING) until its next release.
+            Real-time processes preempt other processes on timer interrupts.
+            PIDs are assigned as in NewProcess(); a rejected process doesn't use up a PID.
+    @return True if the process was admitted and created, false if the utilization test failed.
+
+    @note   If the period, deadline or budget is 0, throw std::invalid_argument exception.
+*/
+bool SimOS::NewProcess(unsigned long long period, unsigned long long relativeDeadline, unsigned long long budget)
+{
+    int processID = processes_.peekNextProcessID();
+    if (!cpu_.write().admitRealTimeProcess(processID, RealTimeParameters{period, relativeDeadline, budget}))
+        return false;
+
+    processes_.create(NEW);
+    cpu_.write().recordArrival(processID);
+    processes_.setProcessState(processID, cpu_.write().addProcess(processID));
+    return true;
 }
 
 /*
     @post   Forks the currently running process forks a child.
             The child is placed in the end of the ready-queue.
+            A running thread forks its process.
 
     @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
 */
 void SimOS::SimFork()
 {
-    if (cpu_.isBusy())
+    if (cpu_->isBusy())
+    {
+        int currProcessID = processes_.getOwnerProcessID(cpu_->getCurrentProcessID());
+        processes_.setProcessType(currProcessID, PARENT);    //Mark the current process as parent
+        int childProcessID = processes_.create(NEW, CHILD, currProcessID);  //Create the child, which the parent's record now lists as its youngest child
+        cpu_.write().recordArrival(childProcessID);
+        processes_.setProcessState(childProcessID, cpu_.write().addProcess(childProcessID));   //Send the child to the CPU and update the process's state
+    }
+    else
+        throw std::logic_error("This instruction requires a running process");
+}
+
+/*
+    @param  The number of processes to create.
+    @post   Same as calling NewProcess() the given number of times, but the process table, the scheduling records and the ready-queue each grow once.
+            The processes get consecutive PIDs from fresh process table slots, even if recycled slots are available.
+    @return An std::pair object with the first and last PIDs of the new processes.
+            std::pair<0, 0> if the count is 0.
+*/
+std::pair<int, int> SimOS::NewProcesses(unsigned int count)
+{
+    if (count == 0)
+        return std::make_pair(0, 0);
+
+    int firstProcessID = processes_.createRange(count, READY);
+    cpu_.write().recordArrivals(firstProcessID, count);
+    if (cpu_.write().addProcesses(firstProcessID, count) == RUNNING)
+        processes_.setProcessState(firstProcessID, RUNNING);
+    return std::make_pair(firstProcessID, firstProcessID + static_cast<int>(count) - 1);
+}
+
+/*
+    @param  The number of children to fork.
+    @post   Same as calling SimFork() the given number of times, but the process table, the scheduling records and the ready-queue each grow once.
+            The children get consecutive PIDs from fresh process table slots and are placed in the end of the ready-queue in PID order.
+            A running thread forks its process.
+    @return An std::pair object with the first and last PIDs of the children.
+            std::pair<0, 0> if the count is 0.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+std::pair<int, int> SimOS::SimForkN(unsigned int count)
+{
+    if (cpu_->isBusy())
+    {
+        if (count == 0)
+            return std::make_pair(0, 0);
+
+        int currProcessID = processes_.getOwnerProcessID(cpu_->getCurrentProcessID());
+        processes_.setProcessType(currProcessID, PARENT);
+        int firstChildID = processes_.createRange(count, READY, CHILD, currProcessID);
+        cpu_.write().recordArrivals(firstChildID, count);
+        cpu_.write().addProcesses(firstChildID, count);
+        return std::make_pair(firstChildID, firstChildID + static_cast<int>(count) - 1);
+    }
+    else
+        throw std::logic_error("This instruction requires a running process");
+}
+
+/*
+    @post   Creates a new thread in the process of the running process or thread, and places it in the end of the ready-queue.
+            The thread runs in the process's address space, so its memory accesses use and load the process's pages.
+            It is scheduled on its own, can block on disk I/O on its own, and its CPU, I/O and page fault statistics are reported by GetProcessMetrics().
+            Thread IDs come from the same sequence as PIDs. A thread terminates when it calls SimExit(), or together with its process.
+    @return The ID of the new thread.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+int SimOS::NewThread()
+{
+    if (cpu_->isBusy())
     {
-        int currProcessID = cpu_.getCurrentProcessID();    
-        allProcesses_[currProcessID].setProcessType(PARENT);    //Mark the current process as parent
-        Process childProcess(allProcesses_.size(), NEW, CHILD, currProcessID);  //Construct the child
-        allProcesses_[currProcessID].addChildProcessID(childProcess.getProcessID());    //Make sure the parent knows it has a child
-        allProcesses_.push_back(childProcess);
-        allProcesses_[childProcess.getProcessID()].setProcessState(cpu_.addProcess(childProcess.getProcessID()));   //Send the child to the CPU and update the process's state
+        int threadID = processes_.createThread(processes_.getOwnerProcessID(cpu_->getCurrentProcessID()), NEW);
+        cpu_.write().recordArrival(threadID);
+        processes_.setProcessState(threadID, cpu_.write().addProcess(threadID));
+        return threadID;
     }
     else
         throw std::logic_error("This instruction requires a running process");
@@ -64,6 +156,7 @@ void SimOS::SimFork()
             If a parent hasn't called wait yet, the process turns into a zombie process.
             To avoid the appearance of the orphans, the system implements cascading termination.
             In this context, cascading termination means that if a process terminates, all its descendants terminate with it.
+            The threads of a terminating process terminate with it. A running thread that exits terminates alone and leaves the process's memory in place.
 
     @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
     @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
@@ -72,28 +165,51 @@ void SimOS::SimFork()
 */
 void SimOS::SimExit()
 {
-    if (cpu_.isBusy())
+    if (cpu_->isBusy())
     {
-        int currentProcess = cpu_.getCurrentProcessID();
-        ram_.findAndClearMemoryUsedByAProcess(currentProcess);
+        int currentProcess = cpu_->getCurrentProcessID();
+        cpu_.write().recordCompletion(currentProcess);
+        if (processes_.isThread(currentProcess))
+        {
+            //Nobody waits for a thread, and the memory it used belongs to its process
+            processes_.release(currentProcess);
+            std::pair<int, int> newCurrentProcess = cpu_.write().runFirstProcess();
+            processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);
+            return;
+        }
+        ram_.write().findAndClearMemoryUsedByAProcess(currentProcess);
+        terminated_.clear();
+        bool hadThreads = findThreadsAndTerminateThem(currentProcess, terminated_);
 
         // Logic for cascading termination [By the nature of SimFork(), any process with children is going to be a Parent]
-        if (allProcesses_[currentProcess].getProcessType() == PARENT) 
-            findChildrenProcessesAndTerminateThem(currentProcess);
+        if (processes_.getProcessType(currentProcess) == PARENT) 
+            findChildrenProcessesAndTerminateThem(currentProcess, terminated_);  //Also sweeps out the threads
+        else if (hadThreads)
+        {
+            findAndRemoveZombiesOrTerminatedProcesses();
+            cancelDiskRequests(terminated_);
+            removeReleasedProcessesFromMessageQueues();
+            removeReleasedProcessesFromVolumes();
+            removeReleasedProcessesFromFileSystems();
+        }
 
-        allProcesses_[currentProcess].setProcessType(ZOMBIE);
+        processes_.setProcessType(currentProcess, ZOMBIE);
 
         //If there's a waiting parent and it was successfully resumed, then the current process is now terminated
-        int parentProcessID = allProcesses_[currentProcess].getParentProcessID();
-        if (allProcesses_[parentProcessID].getProcessState() == WAITING)
+        //A process without a parent has no one to wait for it, so it is terminated right away
+        int parentProcessID = processes_.getParentProcessID(currentProcess);
+        if (parentProcessID == NO_PROCESS)
+            processes_.setProcessState(currentProcess, TERMINATED);
+        else if (processes_.isWaitingForChild(parentProcessID))
         {
             if(findParentProcessAndResumeIt(parentProcessID))
-                allProcesses_[currentProcess].setProcessState(TERMINATED);
+                processes_.setProcessState(currentProcess, TERMINATED);
         }
+        if (processes_.getProcessState(currentProcess) == TERMINATED)
+            processes_.release(currentProcess);
 
-        findAndRemoveZombiesOrTerminatedProcesses();    //Remove any zombies or terminated processes from the ready queue
-        std::pair<int, int> newCurrentProcess = cpu_.runFirstProcess();
-        allProcesses_[newCurrentProcess.first].setProcessState(newCurrentProcess.second);
+        std::pair<int, int> newCurrentProcess = cpu_.write().runFirstProcess();
+        processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);
     }
     else
         throw std::logic_error("This instruction requires a running process");
@@ -111,18 +227,19 @@ void SimOS::SimExit()
 */
 void SimOS::SimWait()
 {
-    if (cpu_.isBusy())
+    if (cpu_->isBusy())
     {
-        std::vector<Process>::iterator waitProcess = findProcessByID(cpu_.getCurrentProcessID());
-        if (!waitProcess->getChildProcesses().empty())  //If the process has children
+        int waitProcessID = cpu_->getCurrentProcessID();
+        if (processes_.hasChildren(waitProcessID))  //If the process has children
         {
             bool zombieFlag = findZombieProcessAndTerminateIt();
-            if(!zombieFlag && !cpu_.getReadyQueue().empty())
+            if(!zombieFlag && cpu_->hasReadyProcess())
             {
-                std::pair<int, int> newCurrentProcess = cpu_.runFirstProcess(); //Run the next process
-                allProcesses_[newCurrentProcess.first].setProcessState(newCurrentProcess.second);   //Update the new current process's information in the record
-                waitProcess->setProcessState(WAITING);  //Set the process state to waiting
-                waitingProcesses_.push_back(*waitProcess);  //Add the process to the waiting processes vector
+                std::pair<int, int> newCurrentProcess = cpu_.write().runFirstProcess(); //Run the next process
+                processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);   //Update the new current process's information in the record
+                processes_.setProcessState(waitProcessID, WAITING);  //Set the process state to waiting
+                cpu_.write().recordBlocked(waitProcessID, false);
+                processes_.setWaitingForChild(waitProcessID, true);  //Flag the process so its children find it waiting when they exit
             }
             //If a zombie was terminated, then the process continues using the CPU like nothing happened
         }
@@ -134,21 +251,26 @@ void SimOS::SimWait()
 
 /*
     @post   Interrupt arrives from the timer signaling that the time slice of the currently running process is over.
+            Real-time processes whose next job was released become ready, and a real-time job may preempt the running process.
 
     @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
 */
 void SimOS::TimerInterrupt()
 {
-    if (cpu_.isBusy())
-    {
-        int interruptedProcess = cpu_.getCurrentProcessID();
-        std::pair<int, int> newCurrentProcess = cpu_.timerInterrupt();
-        allProcesses_[newCurrentProcess.first].setProcessState(newCurrentProcess.second);   //Update the new current process's information in the record
-        if(newCurrentProcess.first != interruptedProcess)   
-            allProcesses_[interruptedProcess].setProcessState(READY);   //If the interrupted process was sent to the ready queue, update it's state in the record to reflect this
-    }
-    else
-        throw std::logic_error("This instruction requires a running process");
+    timerInterruptWith(RoundRobinScheduling());
+}
+
+/*
+    @param  The number of timer interrupts to apply.
+    @post   Same as calling TimerInterrupt() the given number of times, but the rotation of the ready-queue is computed arithmetically where possible,
+            and only the interrupted and the final running process have their states updated.
+            Stops early if the CPU becomes idle (only possible when real-time processes go to sleep).
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+void SimOS::TimerInterrupt(unsigned long long count)
+{
+    timerInterruptsWith(RoundRobinScheduling(), count);
 }
 
 /*
@@ -156,21 +278,80 @@ void SimOS::TimerInterrupt()
     @param  The name of the file to be read.
     @post   Currently running process requests to read the specified file from the disk with a given number.
             The process issuing disk reading requests immediately stops using the CPU, even if the ready-queue is empty.
+            The file is on cylinder 0; see DiskReadRequest(diskNumber, fileName, cylinder).
 
     @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
     @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
 */
-void SimOS::DiskReadRequest(int diskNumber, std::string fileName)
+void SimOS::DiskReadRequest(int diskNumber, const std::string& fileName)
 {
-    if (diskNumber >= disks_.size() || diskNumber < 0)
-        throw std::out_of_range("The disk with the requested number does not exist");
-    else
-    {
-        FileReadRequest newRequest{cpu_.getCurrentProcessID(), fileName};
-        disks_[diskNumber].addToQueue(newRequest);
-        std::pair<int, int> newCurrentProcess = cpu_.runFirstProcess();
-        allProcesses_[newCurrentProcess.first].setProcessState(newCurrentProcess.second);
-    }
+    DiskReadRequest(diskNumber, InternFileName(fileName), 0);
+}
+
+/*
+    @param  The number of the disk that contains the file to be read.
+    @param  The name of the file to be read.
+    @param  The cylinder the file is on, which the disk scheduling policy and the seek statistics use.
+    @post   Same as DiskReadRequest(diskNumber, fileName), for a file on the given cylinder.
+            With the file block cache on, a read of a cached file is a hit: the process keeps the CPU and the disk isn't used.
+
+    @note   If a disk with the requested number or the cylinder doesn’t exist throw std::out_of_range exception.
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+void SimOS::DiskReadRequest(int diskNumber, const std::string& fileName, unsigned long long cylinder)
+{
+    DiskReadRequest(diskNumber, InternFileName(fileName), cylinder);
+}
+
+/*
+    @param  The number of the disk that contains the file to be read.
+    @param  The ID of the name of the file to be read, from InternFileName().
+    @param  The cylinder the file is on.
+    @post   Same as DiskReadRequest(diskNumber, fileName, cylinder). The request is a plain record holding the ID instead of a copy of the name.
+
+    @note   If a disk with the requested number, the file name ID or the cylinder doesn’t exist throw std::out_of_range exception.
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+void SimOS::DiskReadRequest(int diskNumber, int fileNameID, unsigned long long cylinder)
+{
+    diskReadRequestWith(LRUReplacement(), diskNumber, fileNameID, cylinder);
+}
+
+/*
+    @param  The reads to submit, in order.
+    @post   Same as calling DiskReadRequest(diskNumber, fileNameID, cylinder) once per submission: each read is issued by the process running when its turn comes,
+            which then blocks unless the read hits the file block cache, so a batch can carry the reads of many processes.
+            The state of the process left running is recorded once for the whole batch. Submission stops early if the CPU becomes idle.
+    @return The number of submissions made, which is less than the number given if the CPU became idle.
+
+    @note   If any submission names a disk, file name ID or cylinder that doesn’t exist throw std::out_of_range exception, before any submission is made.
+*/
+unsigned int SimOS::SubmitDiskReads(const std::vector<DiskSubmission>& submissions)
+{
+    return submitDiskReadsWith(LRUReplacement(), submissions);
+}
+
+/*
+    @param  The disks that completed a job, one entry per completion, in order. A disk can appear more than once.
+    @post   Same as calling DiskJobCompleted(diskNumber) once per entry.
+    @return The finished requests, in order. An entry for an idle disk finishes nothing and has no completion.
+
+    @note   If any disk number doesn’t exist throw std::out_of_range exception, before any job is completed.
+*/
+std::vector<DiskCompletion> SimOS::CompleteDiskJobs(const std::vector<int>& diskNumbers)
+{
+    return completeDiskJobsWith(FCFSDiskScheduling(), diskNumbers);
+}
+
+/*
+    @param  A file name.
+    @post   The name is added to the simulation's file name table if it isn't in it yet.
+    @return The ID of the name, for DiskReadRequest(diskNumber, fileNameID, cylinder). The same name always gets the same ID.
+*/
+int SimOS::InternFileName(const std::string& fileName)
+{
+    int fileNameID = fileNames_->find(fileName);
+    return fileNameID != -1 ? fileNameID : fileNames_.write().intern(fileName);
 }
 
 /*
@@ -183,14 +364,19 @@ void SimOS::DiskReadRequest(int diskNumber, std::string fileName)
 */
 void SimOS::DiskJobCompleted(int diskNumber)
 {
-    if (diskNumber >= disks_.size())
-        throw std::out_of_range("The disk with the requested number does not exist");
-    else
-    {
-        int finishedProcess = disks_[diskNumber].getCurrentFileReadRequest().PID;
-        allProcesses_[finishedProcess].setProcessState(cpu_.addProcess(finishedProcess));
-        disks_[diskNumber].serveNextProcess();
-    }
+    diskJobCompletedWith(FCFSDiskScheduling(), diskNumber);
+}
+
+/*
+    @param  The number of the disk.
+    @param  The in-flight slot whose job completed. Slots complete in any order.
+    @post   Same as DiskJobCompleted(diskNumber), for the job in the given slot. The slot then serves the next waiting request.
+
+    @note   If a disk with the requested number or the slot doesn’t exist throw std::out_of_range exception.
+*/
+void SimOS::DiskJobCompleted(int diskNumber, unsigned int slot)
+{
+    diskJobCompletedWith(FCFSDiskScheduling(), diskNumber, slot);
 }
 
 /*
@@ -203,12 +389,137 @@ void SimOS::DiskJobCompleted(int diskNumber)
 */
 void SimOS::AccessMemoryAddress(unsigned long long address)
 {
-    if (cpu_.isBusy())
+    accessMemoryAddressWith(LRUReplacement(), address);
+}
+
+/*
+    @param  The size of the segment in bytes, rounded up to whole pages.
+    @post   A shared memory segment is created that processes can attach to with AttachSharedMemory().
+    @return The ID of the segment.
+
+    @note   If the size is 0, throw std::invalid_argument exception.
+*/
+int SimOS::CreateSharedMemory(unsigned long long size)
+{
+    unsigned int pageSize = ram_->getPageSize();
+    return ram_.write().createSharedSegment(size / pageSize + (size % pageSize != 0));
+}
+
+/*
+    @param  The ID of the segment.
+    @param  The logical address the segment starts at, rounded down to the start of its page.
+    @post   The running process (the process of a running thread) maps the segment from that page on.
+            Its accesses in that range use the same frames as every other process attached to the segment.
+
+    @note   If the CPU is idle, throw std::logic_error exception.
+    @note   If there is no such segment, throw std::out_of_range exception.
+    @note   If the range overlaps a segment the process already attached, throw std::invalid_argument exception.
+*/
+void SimOS::AttachSharedMemory(int segmentID, unsigned long long address)
+{
+    if (!cpu_->isBusy())
+        throw std::logic_error("This instruction requires a running process");
+    int processID = processes_.getOwnerProcessID(cpu_->getCurrentProcessID());
+    ram_.write().attachSharedSegment(processID, segmentID, address / ram_->getPageSize());
+}
+
+/*
+    @param  The ID of the segment.
+    @post   The running process (the process of a running thread) no longer maps the segment.
+            The frames of the segment are freed once no process is attached to it anymore.
+
+    @note   If the CPU is idle, or the process isn't attached to the segment, throw std::logic_error exception.
+*/
+void SimOS::DetachSharedMemory(int segmentID)
+{
+    if (!cpu_->isBusy())
+        throw std::logic_error("This instruction requires a running process");
+    ram_.write().detachSharedSegment(processes_.getOwnerProcessID(cpu_->getCurrentProcessID()), segmentID);
+}
+
+/*
+    @param  The number of messages the queue can hold.
+    @post   A message queue is created that processes can send message handles through. Queues are numbered from 0.
+    @return The number of the queue.
+
+    @note   If the capacity is 0, throw std::invalid_argument exception.
+*/
+int SimOS::CreateMessageQueue(unsigned int capacity)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("A message queue needs room for at least one message");
+    messageQueues_.push_back(CopyOnWrite<MessageQueue>{MessageQueue{capacity}});
+    return static_cast<int>(messageQueues_.size()) - 1;
+}
+
+/*
+    @param  The number of the queue.
+    @param  The handle of the payload, which is passed on as-is.
+    @post   The running process sends the handle. If a process is blocked receiving from the queue, the first one gets the message and returns to the ready-queue.
+            The sender never blocks; a full queue rejects the message.
+    @return True if the message was sent, false if the queue was full.
+
+    @note   If a queue with the requested number doesn't exist throw std::out_of_range exception.
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+bool SimOS::SendMessage(int queueNumber, unsigned long long handle)
+{
+    if (queueNumber < 0 || static_cast<std::size_t>(queueNumber) >= messageQueues_.size())
+        throw std::out_of_range("The message queue with the requested number does not exist");
+    if (!cpu_->isBusy())
+        throw std::logic_error("This instruction requires a running process");
+
+    int wokenReceiver{NO_PROCESS};
+    if (!messageQueues_[queueNumber].write().send(Message{cpu_->getCurrentProcessID(), handle, cpu_->getCurrentTime()}, wokenReceiver))
+        return false;
+    if (wokenReceiver != NO_PROCESS)
     {
-        ram_.accessMemoryAtAddress(cpu_.getCurrentProcessID(), address);
+        cpu_.write().recordUnblocked(wokenReceiver);
+        processes_.setProcessState(wokenReceiver, cpu_.write().addProcess(wokenReceiver));
     }
-    else
+    return true;
+}
+
+/*
+    @param  The number of the queue.
+    @post   The running process receives the oldest message in the queue, or the message that woke it if it was blocked on the queue.
+            If there is no message, the process blocks (WAITING) until one is sent, and the next process in the ready-queue starts using the CPU.
+            A woken process gets its message by calling ReceiveMessage() again.
+    @return The message received, or a message with sender NO_PROCESS if the process blocked.
+
+    @note   If a queue with the requested number doesn't exist throw std::out_of_range exception.
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+Message SimOS::ReceiveMessage(int queueNumber)
+{
+    if (queueNumber < 0 || static_cast<std::size_t>(queueNumber) >= messageQueues_.size())
+        throw std::out_of_range("The message queue with the requested number does not exist");
+    if (!cpu_->isBusy())
         throw std::logic_error("This instruction requires a running process");
+
+    int receiver = cpu_->getCurrentProcessID();
+    Message message;
+    if (!messageQueues_[queueNumber].write().receive(receiver, cpu_->getCurrentTime(), message))
+    {
+        processes_.setProcessState(receiver, WAITING);
+        cpu_.write().recordBlocked(receiver, false);
+        std::pair<int, int> newCurrentProcess = cpu_.write().runFirstProcess();
+        processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);
+    }
+    return message;
+}
+
+/*
+    @param  The number of the queue.
+    @return The depth, throughput and stall counters of the queue, with the percentiles of the simulated time from sending a message to receiving it.
+
+    @note   If a queue with the requested number doesn't exist throw std::out_of_range exception.
+*/
+MessageQueueStats SimOS::GetMessageQueueStats(int queueNumber)
+{
+    if (queueNumber < 0 || static_cast<std::size_t>(queueNumber) >= messageQueues_.size())
+        throw std::out_of_range("The message queue with the requested number does not exist");
+    return messageQueues_[queueNumber]->getStats();
 }
 
 /*
@@ -217,8 +528,8 @@ void SimOS::AccessMemoryAddress(unsigned long long address)
 */
 int SimOS::GetCPU()
 {
-    if (cpu_.isBusy())
-        return cpu_.getCurrentProcessID();
+    if (cpu_->isBusy())
+        return cpu_->getCurrentProcessID();
     else
         return NO_PROCESS;
 }
@@ -226,10 +537,14 @@ int SimOS::GetCPU()
 /*
     @return The std::deque containing PIDs of processes in the ready-queue.
             Here, the front element corresponds with the start of the ready-queue.
+            Ready real-time processes come first, earliest deadline first, followed by the round-robin ready-queue.
 */
 std::deque<int> SimOS::GetReadyQueue()
 {
-    return cpu_.getReadyQueue();
+    std::deque<int> readyQueue = cpu_->getReadyQueue();
+    std::vector<int> realTimeQueue = cpu_->getRealTimeQueue();
+    readyQueue.insert(readyQueue.begin(), realTimeQueue.begin(), realTimeQueue.end());
+    return readyQueue;
 }
 
 /*
@@ -241,7 +556,7 @@ std::deque<int> SimOS::GetReadyQueue()
 */
 MemoryUsage SimOS::GetMemory()
 {
-    return ram_.getMemoryUsage();
+    return ram_->getMemoryUsage();
     //Specifications said that "MemoryItems appear in the MemoryUsage vector in the order they appear in memory (from low addresses to high)."
     //Does this mean that we need to sort the MemoryUsage, and if yes, do we sort by PageNumber or FrameNumber?
     //Since this was not specified, I'll implement it so that the rightmost element of the memoryusage vector contains the most recently added page.
@@ -250,6 +565,7 @@ MemoryUsage SimOS::GetMemory()
 /*
     @param  The number of the disk.
     @return An object with PID of the process served by the specified disk and the name of the file read for that process.
+            If the disk serves several requests at once, the one that has been in flight the longest is returned.
             If the disk is idle, the default FileReadRequest object (with PID 0 and empty string in fileName) is returned.
 
     @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
@@ -259,7 +575,209 @@ FileReadRequest SimOS::GetDisk(int diskNumber)
     if (diskNumber >= disks_.size())
         throw std::out_of_range("The disk with the requested number does not exist");
     else
-        return disks_[diskNumber].getCurrentFileReadRequest();
+        return toFileReadRequest(disks_[diskNumber]->getCurrentDiskRequest());
+}
+
+/*
+    @param  The number of the disk.
+    @param  The in-flight slot.
+    @return The request served in the slot, or the default FileReadRequest object if the slot is free.
+
+    @note   If a disk with the requested number or the slot doesn’t exist throw std::out_of_range exception.
+*/
+FileReadRequest SimOS::GetDisk(int diskNumber, unsigned int slot)
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    else if (slot >= disks_[diskNumber]->getSlotCount())
+        throw std::out_of_range("The disk has no slot with this number");
+    else
+        return toFileReadRequest(disks_[diskNumber]->getDiskRequest(slot));
+}
+
+/*
+    @return Counts and p50/p95/p99 summaries of the turnaround, waiting and response times and context switches of all processes.
+            Times are measured in simulated time units; the clock advances by one time quantum on every timer interrupt.
+*/
+SchedulingSummary SimOS::GetSchedulingStats()
+{
+    return cpu_->getStats().getSummary();
+}
+
+/*
+    @param  The PID of a process, or the ID of a thread.
+    @return The arrival and first run times, ready-queue wait, CPU quanta, I/O wait, context switches, memory accesses, page faults and completion time of the process or thread.
+
+    @note   If no process with the requested PID was ever created, throw std::out_of_range exception.
+*/
+ProcessMetrics SimOS::GetProcessMetrics(int processID)
+{
+    return cpu_->getProcessMetrics(processID);
+}
+
+/*
+    @param  The length of a time slice in simulated time units.
+    @post   Every following timer interrupt advances the simulated clock by the new time quantum.
+*/
+void SimOS::SetTimeQuantum(unsigned long long timeQuantum)
+{
+    cpu_.write().setTimeQuantum(timeQuantum);
+}
+
+/*
+    @param  The fixed time every context switch takes.
+    @param  The time a process needs to warm its caches and TLB back up when its state is fully cold.
+    @param  The time away from the CPU after which a process's state is fully cold.
+            A process that was away for a shorter time pays a proportional part of the warm-up penalty.
+            0 makes every process that was switched out pay the full penalty.
+    @post   Context switches advance the simulated clock by their cost from now on.
+*/
+void SimOS::SetContextSwitchCost(unsigned long long switchOverhead, unsigned long long warmupPenalty, unsigned long long warmthWindow)
+{
+    cpu_.write().setContextSwitchCost(ContextSwitchCost{switchOverhead, warmupPenalty, warmthWindow});
+}
+
+/*
+    @return The number of context switches, the time spent on switch overhead and cache warm-up,
+            and the fraction of busy CPU time that went to running processes.
+*/
+ContextSwitchReport SimOS::GetContextSwitchReport()
+{
+    return cpu_->getContextSwitchReport();
+}
+
+/*
+    @return Admitted and rejected real-time processes, released and completed jobs, deadline misses,
+            the reserved utilization and the lateness and slack distributions of completed jobs.
+*/
+RealTimeReport SimOS::GetRealTimeReport()
+{
+    return cpu_->getRealTimeReport();
+}
+
+/*
+    @param  True to reuse the process table slots of terminated processes, false to give every new process the next PID.
+    @post   With recycling on, the memory held by the process table stays bounded by the number of processes alive at once.
+            A recycled slot is tagged with a new generation, so PIDs stay unique; only the numbering is no longer sequential.
+            Only the first MAX_RECYCLED_PROCESS_SLOTS (2^24) slots are recycled, each up to MAX_PROCESS_GENERATION times.
+*/
+void SimOS::SetProcessIDRecycling(bool recycling)
+{
+    processes_.setRecycling(recycling);
+}
+
+/*
+    @param  The path of the checkpoint file.
+    @post   The whole simulation is written to the file: the process table, the CPU with its ready-queue, clock and statistics,
+            every disk with its queue, the memory frames with their "recently used" order, the message queues, the volumes, the replica sets and the file system of every disk.
+            The file is a versioned binary snapshot whose arrays are stored raw and 8 byte aligned.
+
+    @note   If the file can't be written, throw std::runtime_error exception.
+*/
+void SimOS::SaveCheckpoint(std::string path)
+{
+    CheckpointWriter writer{path};
+
+    writer.writeTag("PROCESS");
+    processes_.writeCheckpoint(writer);
+    writer.writeTag("CPU");
+    cpu_->writeCheckpoint(writer);
+    writer.writeTag("DISKS");
+    writer.write(static_cast<std::uint64_t>(disks_.size()));
+    for (const CopyOnWrite<DiskManager>& disk : disks_)
+        disk->writeCheckpoint(writer);
+    writer.writeTag("MEMORY");
+    ram_->writeCheckpoint(writer);
+    writer.writeTag("FILES");
+    fileNames_->writeCheckpoint(writer);
+    writer.writeTag("MESSAGES");
+    writer.write(static_cast<std::uint64_t>(messageQueues_.size()));
+    for (const CopyOnWrite<MessageQueue>& queue : messageQueues_)
+        queue->writeCheckpoint(writer);
+    writer.writeTag("VOLUMES");
+    writer.write(static_cast<std::uint64_t>(volumes_.size()));
+    for (const CopyOnWrite<Volume>& volume : volumes_)
+        volume->writeCheckpoint(writer);
+    writer.writeTag("REPLICAS");
+    writer.write(static_cast<std::uint64_t>(replicaSets_.size()));
+    for (const CopyOnWrite<ReplicaSet>& replicaSet : replicaSets_)
+        replicaSet->writeCheckpoint(writer);
+    writer.writeTag("FILESYS");
+    for (const CopyOnWrite<FileSystem>& fileSystem : fileSystems_)
+        fileSystem->writeCheckpoint(writer);
+
+    writer.finish();
+}
+
+/*
+    @param  The path of a file written by SaveCheckpoint().
+    @post   The simulation continues from the state it was in when the checkpoint was saved, including the number of disks and the RAM geometry.
+            If the checkpoint can't be loaded, the simulation is left unchanged.
+
+    @note   If the file can't be read, isn't a checkpoint of this version, or is corrupt, throw std::runtime_error exception.
+*/
+void SimOS::LoadCheckpoint(std::string path)
+{
+    CheckpointReader reader{path};
+    ProcessTable processes;
+    CPUManager cpu;
+    std::vector<CopyOnWrite<DiskManager>> disks;
+    MemoryManager ram;
+    std::vector<CopyOnWrite<MessageQueue>> messageQueues;
+    std::vector<CopyOnWrite<Volume>> volumes;
+    std::vector<CopyOnWrite<ReplicaSet>> replicaSets;
+    std::vector<CopyOnWrite<FileSystem>> fileSystems;
+    FileNameTable fileNames;
+
+    reader.expectTag("PROCESS");
+    processes.readCheckpoint(reader);
+    reader.expectTag("CPU");
+    cpu.readCheckpoint(reader);
+    reader.expectTag("DISKS");
+    disks.resize(reader.read<std::uint64_t>());
+    for (CopyOnWrite<DiskManager>& disk : disks)
+        disk.write().readCheckpoint(reader);
+    reader.expectTag("MEMORY");
+    ram.readCheckpoint(reader);
+    reader.expectTag("FILES");
+    fileNames.readCheckpoint(reader);
+    reader.expectTag("MESSAGES");
+    messageQueues.resize(reader.read<std::uint64_t>());
+    for (CopyOnWrite<MessageQueue>& queue : messageQueues)
+        queue.write().readCheckpoint(reader);
+    reader.expectTag("VOLUMES");
+    volumes.resize(reader.read<std::uint64_t>());
+    for (CopyOnWrite<Volume>& volume : volumes)
+        volume.write().readCheckpoint(reader);
+    reader.expectTag("REPLICAS");
+    replicaSets.resize(reader.read<std::uint64_t>());
+    for (CopyOnWrite<ReplicaSet>& replicaSet : replicaSets)
+        replicaSet.write().readCheckpoint(reader);
+    reader.expectTag("FILESYS");
+    fileSystems.resize(disks.size());
+    for (CopyOnWrite<FileSystem>& fileSystem : fileSystems)
+        fileSystem.write().readCheckpoint(reader);
+    reader.expectTag("END");
+
+    processes_ = std::move(processes);
+    cpu_ = CopyOnWrite<CPUManager>{std::move(cpu)};
+    disks_ = std::move(disks);
+    ram_ = CopyOnWrite<MemoryManager>{std::move(ram)};
+    messageQueues_ = std::move(messageQueues);
+    volumes_ = std::move(volumes);
+    replicaSets_ = std::move(replicaSets);
+    fileSystems_ = std::move(fileSystems);
+    fileNames_ = CopyOnWrite<FileNameTable>{std::move(fileNames)};
+}
+
+/*
+    @return An independent copy of the simulation, for running what-if variants from one warmed-up state.
+            The copy shares the CPU, the disks and the memory, and the chunks of the process table and the scheduling records, with this simulation.
+            Either side copies a shared part only when it first changes it, so a clone costs memory in proportion to what it changes.
+*/
+SimOS SimOS::Clone() const
+{
+    return *this;
 }
 
 //--------------------------------------------Helper Functions--------------------------------------------
@@ -275,99 +793,606 @@ std::deque<FileReadRequest> SimOS::GetDiskQueue(int diskNumber)
         throw std::out_of_range("The disk with the requested number does not exist");
     else
     {
-        return disks_[diskNumber].getDiskQueue();
+        std::deque<FileReadRequest> diskQueue;
+        for (const DiskRequest& request : disks_[diskNumber]->getDiskQueue())
+            diskQueue.push_back(toFileReadRequest(request));
+        return diskQueue;
     }
 }
 
+/*
+    @param  The number of the disk.
+    @return The number of requests the disk served, the distance its head travelled to serve them, and where the head is now.
+
+    @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
+*/
+DiskSeekStats SimOS::GetDiskSeekStats(int diskNumber)
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    return disks_[diskNumber]->getSeekStats();
+}
+
+/*
+    @param  The number of the disk.
+    @param  The seek, rotation and transfer times of the disk, or its constant latency if it's SSD-like.
+    @post   Requests the disk starts from now on take the time the model gives them. Disks serve requests instantly until they are given a model.
+
+    @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
+*/
+void SimOS::SetDiskServiceModel(int diskNumber, DiskServiceModel serviceModel)
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    disks_[diskNumber].write().setServiceModel(serviceModel);
+}
+
+/*
+    @param  The number of the disk.
+    @return The busy time and utilization of the disk, and the percentiles of its queue depth and of the wait, service and response times of its requests.
+            Comparing the reports of the disks shows which one is saturated. The report also counts the requests of terminated processes
+            the disk cancelled, and the service time it didn't spend on them.
+
+    @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
+*/
+DiskReport SimOS::GetDiskReport(int diskNumber)
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    return disks_[diskNumber]->getReport(cpu_->getCurrentTime());
+}
+
+/*
+    @param  The number of the disk.
+    @param  The number of hardware queues. A waiting request is kept in the queue of its process, and free slots take requests from the queues in turn.
+    @param  The number of requests the disk serves at once, each in its own slot. Jobs in different slots complete in any order.
+    @post   The disk serves requests in parallel, like a multi-queue SSD. Every disk starts with one hardware queue and one slot.
+
+    @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
+    @note   If the number of hardware queues or slots is 0 throw std::invalid_argument exception.
+    @note   If the disk has requests in flight or waiting throw std::logic_error exception.
+*/
+void SimOS::SetDiskParallelism(int diskNumber, unsigned int hardwareQueues, unsigned int slots)
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    else if (hardwareQueues == 0 || slots == 0)
+        throw std::invalid_argument("A disk needs at least one hardware queue and one slot");
+    else if (!disks_[diskNumber]->isIdle())
+        throw std::logic_error("Only an idle disk can change its parallelism");
+    disks_[diskNumber].write().setParallelism(hardwareQueues, slots);
+}
+
+/*
+    @param  The RAID level of the volume: RAID0, RAID1 or RAID5.
+    @param  The numbers of the disks the volume is made of. RAID-0 needs at least one disk, RAID-1 at least two and RAID-5 at least three.
+    @post   A volume is created over the disks. Volumes are numbered from 0. The disks still take requests of their own and can be in several volumes.
+    @return The number of the volume.
+
+    @note   If a disk with one of the numbers doesn’t exist throw std::out_of_range exception.
+    @note   If the level isn't one of the above, a disk is listed twice, or there are too few disks for the level, throw std::invalid_argument exception.
+*/
+int SimOS::CreateVolume(int level, std::vector<int> diskNumbers)
+{
+    if (level != RAID0 && level != RAID1 && level != RAID5)
+        throw std::invalid_argument("The RAID level has to be RAID0, RAID1 or RAID5");
+    checkDistinctDisks(diskNumbers);
+    if (diskNumbers.size() < (level == RAID0 ? 1u : level == RAID1 ? 2u : 3u))
+        throw std::invalid_argument("There are too few disks for the RAID level");
+    volumes_.push_back(CopyOnWrite<Volume>{Volume{level, diskNumbers}});
+    return static_cast<int>(volumes_.size()) - 1;
+}
+
+/*
+    @param  The number of the volume.
+    @param  The name of the file to be read.
+    @param  The first block of the volume to read.
+    @param  The number of blocks to read.
+    @post   Same as VolumeReadRequest(volumeNumber, InternFileName(fileName), block, blockCount).
+*/
+void SimOS::VolumeReadRequest(int volumeNumber, const std::string& fileName, unsigned long long block, unsigned int blockCount)
+{
+    VolumeReadRequest(volumeNumber, InternFileName(fileName), block, blockCount);
+}
+
+/*
+    @param  The number of the volume.
+    @param  The ID of the name of the file to be read, from InternFileName().
+    @param  The first block of the volume to read.
+    @param  The number of blocks to read.
+    @post   The currently running process reads the blocks. The read is split into a sub-request per block on the disks the RAID level puts the blocks on,
+            so a read across several disks is served by all of them at once. A degraded RAID-5 rebuilds each block of its failed disk from the rest of the block's row.
+            The process is blocked (WAITING) until its last sub-request completes. Volume reads don't use the file block cache.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+    @note   If a volume with the requested number or the file name ID doesn’t exist, or the blocks go past the end of the volume, throw std::out_of_range exception.
+    @note   If the number of blocks is 0 throw std::invalid_argument exception.
+*/
+void SimOS::VolumeReadRequest(int volumeNumber, int fileNameID, unsigned long long block, unsigned int blockCount)
+{
+    if (!cpu_->isBusy())
+        throw std::logic_error("This instruction requires a running process");
+    else if (volumeNumber < 0 || static_cast<std::size_t>(volumeNumber) >= volumes_.size())
+        throw std::out_of_range("The volume with the requested number does not exist");
+    else if (fileNameID < 0 || static_cast<std::size_t>(fileNameID) >= fileNames_->size())
+        throw std::out_of_range("There is no file name with this ID");
+    else if (blockCount == 0)
+        throw std::invalid_argument("A volume read needs at least one block");
+    else if (block >= volumes_[volumeNumber]->getCapacity() || blockCount > volumes_[volumeNumber]->getCapacity() - block)
+        throw std::out_of_range("The blocks go past the end of the volume");
+
+    int reader = cpu_->getCurrentProcessID();
+    unsigned long long currentTime = cpu_->getCurrentTime();
+    std::vector<VolumeBlock> subrequests = volumes_[volumeNumber]->mapRead(block, blockCount, [this](const int& diskNumber) { return disks_[diskNumber]->getQueueDepth(); });
+    for (const VolumeBlock& subrequest : subrequests)
+        disks_[subrequest.diskNumber].write().addToQueue(DiskRequest{reader, fileNameID, subrequest.cylinder, currentTime});
+    volumes_[volumeNumber].write().startRead(reader, blockCount, subrequests.size(), currentTime);
+
+    processes_.setProcessState(reader, WAITING);
+    cpu_.write().recordBlocked(reader, true);
+    std::pair<int, int> newCurrentProcess = cpu_.write().runFirstProcess();
+    processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);
+}
+
+/*
+    @param  The number of the volume.
+    @param  The index of the disk in the volume, in the order the disks were given to CreateVolume().
+    @post   Reads of the volume stop using the disk: RAID-1 reads go to the other copies, and RAID-5 reads rebuild the disk's blocks from parity.
+            Sub-requests already sent to the disk still complete.
+
+    @note   If a volume with the requested number or the disk doesn’t exist throw std::out_of_range exception.
+    @note   If the volume couldn't read all of its blocks without the disk throw std::logic_error exception.
+*/
+void SimOS::FailVolumeDisk(int volumeNumber, unsigned int member)
+{
+    if (volumeNumber < 0 || static_cast<std::size_t>(volumeNumber) >= volumes_.size())
+        throw std::out_of_range("The volume with the requested number does not exist");
+    else if (member >= volumes_[volumeNumber]->getDiskCount())
+        throw std::out_of_range("The volume has no disk with this index");
+    else if (!volumes_[volumeNumber]->canFailDisk(member))
+        throw std::logic_error("The volume would lose data without this disk");
+    volumes_[volumeNumber].write().setDiskFailed(member);
+}
+
+/*
+    @param  The number of the volume.
+    @return The reads of the volume, the disk requests they were split into, the reconstruction reads of a degraded RAID-5,
+            and the percentiles of the time from a read to the completion of its last sub-request, which show the tail latency of the array.
+
+    @note   If a volume with the requested number doesn’t exist throw std::out_of_range exception.
+*/
+VolumeStats SimOS::GetVolumeStats(int volumeNumber)
+{
+    if (volumeNumber < 0 || static_cast<std::size_t>(volumeNumber) >= volumes_.size())
+        throw std::out_of_range("The volume with the requested number does not exist");
+    return volumes_[volumeNumber]->getStats();
+}
+
+/*
+    @param  How reads of the set choose a disk: STATIC_PLACEMENT, SHORTEST_QUEUE or EARLIEST_COMPLETION.
+    @param  The numbers of the disks that hold copies of the same files.
+    @post   A replica set is created over the disks. Replica sets are numbered from 0. The disks still take requests of their own and can be in several sets.
+    @return The number of the replica set.
+
+    @note   If a disk with one of the numbers doesn’t exist throw std::out_of_range exception.
+    @note   If the placement isn't one of the above, a disk is listed twice, or there are no disks, throw std::invalid_argument exception.
+*/
+int SimOS::CreateReplicaSet(int placement, std::vector<int> diskNumbers)
+{
+    if (placement != STATIC_PLACEMENT && placement != SHORTEST_QUEUE && placement != EARLIEST_COMPLETION)
+        throw std::invalid_argument("The placement has to be STATIC_PLACEMENT, SHORTEST_QUEUE or EARLIEST_COMPLETION");
+    checkDistinctDisks(diskNumbers);
+    if (diskNumbers.empty())
+        throw std::invalid_argument("A replica set needs at least one disk");
+    replicaSets_.push_back(CopyOnWrite<ReplicaSet>{ReplicaSet{placement, diskNumbers}});
+    return static_cast<int>(replicaSets_.size()) - 1;
+}
+
+/*
+    @param  The number of the replica set that holds the file.
+    @param  The name of the file to be read.
+    @param  The cylinder the file is on.
+    @post   Same as ReplicaReadRequest(replicaSetNumber, InternFileName(fileName), cylinder).
+    @return The number of the disk the read was placed on.
+*/
+int SimOS::ReplicaReadRequest(int replicaSetNumber, const std::string& fileName, unsigned long long cylinder)
+{
+    return ReplicaReadRequest(replicaSetNumber, InternFileName(fileName), cylinder);
+}
+
+/*
+    @param  The number of the replica set that holds the file.
+    @param  The ID of the name of the file to be read, from InternFileName().
+    @param  The cylinder the file is on.
+    @post   The placement mode of the set picks one of its disks, from the requests at each disk and their expected completion time,
+            which the disks keep up to date as requests arrive and finish. Then same as DiskReadRequest(diskNumber, fileNameID, cylinder) on that disk.
+    @return The number of the disk the read was placed on.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+    @note   If a replica set with the requested number, the file name ID or the cylinder doesn’t exist throw std::out_of_range exception.
+*/
+int SimOS::ReplicaReadRequest(int replicaSetNumber, int fileNameID, unsigned long long cylinder)
+{
+    return replicaReadRequestWith(LRUReplacement(), replicaSetNumber, fileNameID, cylinder);
+}
+
+/*
+    @param  The number of the replica set.
+    @return The reads placed on the set and how evenly they were spread over its disks, the queue imbalance when they were placed,
+            and the response time percentiles of the set's disks. Comparing sets with different placements over the same workload
+            shows how much tail latency load-aware placement saves.
+
+    @note   If a replica set with the requested number doesn’t exist throw std::out_of_range exception.
+*/
+ReplicaSetStats SimOS::GetReplicaSetStats(int replicaSetNumber)
+{
+    if (replicaSetNumber < 0 || static_cast<std::size_t>(replicaSetNumber) >= replicaSets_.size())
+        throw std::out_of_range("The replica set with the requested number does not exist");
+    ReplicaSetStats stats = replicaSets_[replicaSetNumber]->getStats();
+    Histogram responseTime;
+    for (const int& diskNumber : replicaSets_[replicaSetNumber]->getDisks())
+        responseTime.merge(disks_[diskNumber]->getResponseTimeHistogram());
+    stats.responseTime = responseTime.getSummary();
+    return stats;
+}
+
+/*
+    @param  The number of the disk.
+    @param  The name of the file.
+    @param  The size of the file in blocks. A disk has DEFAULT_DISK_BLOCKS blocks, DEFAULT_BLOCKS_PER_CYLINDER on each cylinder.
+    @post   The file is created on the disk's file system. It takes the first free extent that fits it whole, or if none does,
+            free extents in address order until it has its size, so files created on a disk whose files were deleted are fragmented.
+
+    @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
+    @note   If the size is 0 throw std::invalid_argument exception.
+    @note   If the file is already on the disk throw std::logic_error exception.
+    @note   If the disk doesn't have that many free blocks throw std::runtime_error exception.
+*/
+void SimOS::CreateFile(int diskNumber, const std::string& fileName, unsigned long long sizeInBlocks)
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    else if (sizeInBlocks == 0)
+        throw std::invalid_argument("A file needs at least one block");
+    int fileNameID = InternFileName(fileName);
+    if (fileSystems_[diskNumber]->contains(fileNameID))
+        throw std::logic_error("The file is already on the disk");
+    else if (sizeInBlocks > fileSystems_[diskNumber]->getFreeBlocks())
+        throw std::runtime_error("The disk doesn't have enough free blocks for the file");
+    fileSystems_[diskNumber].write().createFile(fileNameID, sizeInBlocks);
+}
+
+/*
+    @param  The number of the disk.
+    @param  The name of a file on the disk.
+    @post   The file is deleted and its blocks are free, merged with the free blocks around them. Requests already made for it still complete.
+
+    @note   If a disk with the requested number or the file on it doesn’t exist throw std::out_of_range exception.
+*/
+void SimOS::DeleteFile(int diskNumber, const std::string& fileName)
+{
+    fileSystems_[diskNumber].write().deleteFile(findFile(diskNumber, fileName));
+}
+
+/*
+    @param  The number of the disk.
+    @param  The name of a file on the disk.
+    @return The extents of the file, in file order. A file in one piece has one.
+
+    @note   If a disk with the requested number or the file on it doesn’t exist throw std::out_of_range exception.
+*/
+std::vector<Extent> SimOS::GetFileExtents(int diskNumber, const std::string& fileName)
+{
+    int fileNameID = findFile(diskNumber, fileName);
+    return fileSystems_[diskNumber]->getExtents(fileNameID);
+}
+
+/*
+    @param  The number of the disk.
+    @param  The name of a file on the disk.
+    @post   Same as ReadFile(diskNumber, fileName, 0, size of the file).
+*/
+void SimOS::ReadFile(int diskNumber, const std::string& fileName)
+{
+    int fileNameID = findFile(diskNumber, fileName);
+    ReadFile(diskNumber, fileName, 0, fileSystems_[diskNumber]->getFileSize(fileNameID));
+}
+
+/*
+    @param  The number of the disk.
+    @param  The name of a file on the disk.
+    @param  The first block of the file to read.
+    @param  The number of blocks to read.
+    @post   The currently running process reads the blocks. The read becomes one request per extent of the file it touches, each reading a run of consecutive blocks,
+            so its cost depends on how the file is laid out: every extent costs a seek and a rotational delay, and every block a transfer time.
+            The process is blocked (WAITING) until its last request completes. File system reads don't use the file block cache.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+    @note   If a disk with the requested number or the file on it doesn’t exist, or the blocks go past the end of the file, throw std::out_of_range exception.
+    @note   If the number of blocks is 0 throw std::invalid_argument exception.
+*/
+void SimOS::ReadFile(int diskNumber, const std::string& fileName, unsigned long long firstBlock, unsigned long long blockCount)
+{
+    if (!cpu_->isBusy())
+        throw std::logic_error("This instruction requires a running process");
+    int fileNameID = findFile(diskNumber, fileName);
+    unsigned long long fileSize = fileSystems_[diskNumber]->getFileSize(fileNameID);
+    if (blockCount == 0)
+        throw std::invalid_argument("A file read needs at least one block");
+    else if (firstBlock >= fileSize || blockCount > fileSize - firstBlock)
+        throw std::out_of_range("The blocks go past the end of the file");
+
+    int reader = cpu_->getCurrentProcessID();
+    unsigned long long currentTime = cpu_->getCurrentTime();
+    std::vector<Extent> ranges = fileSystems_[diskNumber]->mapRead(fileNameID, firstBlock, blockCount);
+    for (const Extent& range : ranges)
+        disks_[diskNumber].write().addToQueue(DiskRequest{reader, fileNameID, range.firstBlock / DEFAULT_BLOCKS_PER_CYLINDER, currentTime, range.blockCount});
+    fileSystems_[diskNumber].write().startRead(reader, blockCount, ranges.size());
+
+    processes_.setProcessState(reader, WAITING);
+    cpu_.write().recordBlocked(reader, true);
+    std::pair<int, int> newCurrentProcess = cpu_.write().runFirstProcess();
+    processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);
+}
+
+/*
+    @param  The number of the disk.
+    @return The free space and files of the disk's file system, how fragmented its files and free space are, and the reads it split into requests.
+
+    @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
+*/
+FileSystemStats SimOS::GetFileSystemStats(int diskNumber)
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    return fileSystems_[diskNumber]->getStats();
+}
+
+/*
+    @param  True to cache the blocks of files read from the disks, false to stop caching.
+    @post   With the cache on, every file a disk finishes reading is cached in a memory frame. The blocks compete with process pages
+            for frames under the page replacement policy, and a read of a cached file lets the process continue without using the disk.
+            The cache is off by default, so every read goes to the disk.
+*/
+void SimOS::SetFileCache(bool enabled)
+{
+    ram_.write().setFileCacheEnabled(enabled);
+}
+
+/*
+    @return The hits, misses and hit rate of the file block cache, the number of blocks cached,
+            and the disk requests the hits didn't queue behind with the estimated time that saved.
+*/
+FileCacheStats SimOS::GetFileCacheStats()
+{
+    return ram_->getFileCacheStats();
+}
+
+/*
+    @param  The PID of a process.
+    @return The IDs of the live threads of the process, oldest first.
+
+    @note   If no process with the requested PID exists, throw std::out_of_range exception.
+*/
+std::vector<int> SimOS::GetThreads(int processID)
+{
+    return processes_.getThreads(processID);
+}
+
 /*
     @post   Finds the waiting parent process of the currently running process, and changes its state from Waiting to Ready.
-            If parent is waiting, add it to the ready queue and delete it from the collection of waiting processes.
+            If parent is waiting, add it to the ready queue and clear its waiting flag.
+            Takes constant time: the flag in the process table tells whether the parent is waiting.
     @return True if the waiting parent was found and resumed, false otherwise.
 */
 bool SimOS::findParentProcessAndResumeIt(const int& parentProcessID)
 {
-    if (parentProcessID != 0)
+    if (parentProcessID != 0 && processes_.isWaitingForChild(parentProcessID))
     {
-        for (std::vector<Process>::iterator i = waitingProcesses_.begin(); i != waitingProcesses_.end(); i++)
-        {
-            if (i->getProcessID() == parentProcessID)
-            {
-                allProcesses_[i->getProcessID()].setProcessState(cpu_.addProcess(i->getProcessID()));
-                waitingProcesses_.erase(i);
-                return true;
-            }
-        }
+        processes_.setWaitingForChild(parentProcessID, false);
+        cpu_.write().recordUnblocked(parentProcessID);
+        processes_.setProcessState(parentProcessID, cpu_.write().addProcess(parentProcessID));
+        return true;
     }
     return false;
 }
 
 /*
-    @param  A const lvalue iterator to a process in the collection of all processes.
-    @post   Finds, terminates, and clears any memory used by the children of the given process.
+    @param  A const lvalue reference to the ID of a process that is exiting.
+    @param  A reference to the list of processes and threads the exit terminated, holding the exiting process's threads. The descendants and their threads are appended to it.
+    @post   Finds, terminates, and clears any memory used by all descendants of the given process and their threads.
+            The subtree is walked through the process table's child and sibling links, so trees of any depth are handled without recursion or a worklist.
+            Its frames are released in one pass over memory, its entries are swept out of the ready-queue and every disk queue,
+            and the descendants leave the process table, children before their parents.
+            The waiting disk requests of everything in the list are cancelled.
 */
-void SimOS::findChildrenProcessesAndTerminateThem(const int &currProcessID)
+void SimOS::findChildrenProcessesAndTerminateThem(const int &currProcessID, std::vector<int>& terminated)
 {
-    for (int i = 0; i < allProcesses_[currProcessID].getChildProcesses().size(); i++)
+    //Pre-order walk: mark every descendant terminated
+    for (int descendant = processes_.getFirstChild(currProcessID); descendant != NO_PROCESS; )
+    {
+        processes_.setProcessState(descendant, TERMINATED);
+        cpu_.write().recordCompletion(descendant);
+        terminated.push_back(descendant);
+        findThreadsAndTerminateThem(descendant, terminated);
+
+        int next = processes_.getFirstChild(descendant);
+        for (int ancestor = descendant; next == NO_PROCESS && ancestor != currProcessID; ancestor = processes_.getParentProcessID(ancestor))
+            next = processes_.getNextSibling(ancestor);
+        descendant = next;
+    }
+
+    //Terminated processes still in the table are exactly the descendants
+    ram_.write().findAndClearMemoryUsedByProcesses([this](const int& processID)
+    {
+        return processes_.contains(processID) && processes_.getProcessState(processID) == TERMINATED;
+    });
+
+    //Post-order walk: release children before their parents, so the links needed to go on are still there
+    int descendant = processes_.hasChildren(currProcessID) ? processes_.getFirstLeaf(processes_.getFirstChild(currProcessID)) : NO_PROCESS;
+    while (descendant != NO_PROCESS)
     {
-        int childProcess = allProcesses_[currProcessID].getChildProcesses()[i];
-        allProcesses_[childProcess].setProcessState(TERMINATED);
-        ram_.findAndClearMemoryUsedByAProcess(childProcess);
-        if(allProcesses_[childProcess].getProcessType() == PARENT)
-            findChildrenProcessesAndTerminateThem(childProcess);
+        int sibling = processes_.getNextSibling(descendant);
+        int parent = processes_.getParentProcessID(descendant);
+        processes_.release(descendant);
+        if (sibling != NO_PROCESS)
+            descendant = processes_.getFirstLeaf(sibling);
+        else
+            descendant = parent != currProcessID ? parent : NO_PROCESS;
     }
+
+    //Released processes are no longer in the table, which is all the sweeps need to know
+    findAndRemoveZombiesOrTerminatedProcesses();
+    cancelDiskRequests(terminated);
+    removeReleasedProcessesFromMessageQueues();
+    removeReleasedProcessesFromVolumes();
+    removeReleasedProcessesFromFileSystems();
 }
 
 /*
-    @post   Finds, terminates, and clears any memory used by the children of the given process.
-    @return True if found and terminated a zombie, false otherwise
+    @param  A const lvalue reference to the PID of a process that is terminating.
+    @param  A reference to a list the IDs of the terminated threads are appended to.
+    @post   Every thread of the process is terminated and leaves the process table.
+            Threads use their process's memory, so there is nothing to clear; the caller sweeps them out of the ready-queue and the disk queues.
+    @return True if the process had any threads, false otherwise.
 */
-bool SimOS::findZombieProcessAndTerminateIt()
+bool SimOS::findThreadsAndTerminateThem(const int& processID, std::vector<int>& terminated)
 {
-    //Iterating through the children processes vector
-    std::vector<int> childProcesses = allProcesses_[cpu_.getCurrentProcessID()].getChildProcesses();
-    for(auto x : childProcesses)
+    bool hadThreads = false;
+    for (int thread = processes_.getFirstThread(processID); thread != NO_PROCESS; thread = processes_.getFirstThread(processID))
     {
-        if(allProcesses_[x].getProcessType() == ZOMBIE){
-            ram_.findAndClearMemoryUsedByAProcess(x);
-            allProcesses_[x].setProcessState(TERMINATED);
-            return true;
-        }
+        cpu_.write().recordCompletion(thread);
+        processes_.release(thread);
+        terminated.push_back(thread);
+        hadThreads = true;
     }
-    return false;
+    return hadThreads;
 }
 
 /*
-    @param  A const lvalue reference to a process.
-    @return An iterator to a matching process in the collection of all processes.
-
-    @note   Throws an exception if the iterator is pointing to Process 0 (The NO_PROCESS placeholder).
+    @param  A const lvalue reference to the PIDs of the processes and threads that terminated.
+    @post   Cancels their waiting requests on every disk. Each disk indexes its waiting requests by PID, so the cost is proportional
+            to the number of terminated processes and of their requests, not to the length of the disk queues, and a disk a process has
+            nothing waiting on isn't copied away from the clones sharing it. The requests being served are left to finish.
+            Every disk reports the requests cancelled and the service time they would have taken.
 */
-std::vector<Process>::iterator SimOS::findProcess(const Process &process)
+void SimOS::cancelDiskRequests(const std::vector<int>& terminated)
 {
-    std::vector<Process>::iterator iteratorToProcess = allProcesses_.begin();
-    for (iteratorToProcess; iteratorToProcess != allProcesses_.end(); iteratorToProcess++)
+    for (CopyOnWrite<DiskManager>& disk : disks_)
     {
-        if (*iteratorToProcess == process)
-            break;
+        for (const int& processID : terminated)
+        {
+            if (disk->hasWaitingRequests(processID))
+                disk.write().cancelRequests(processID);
+        }
     }
-        
-    return iteratorToProcess;
 }
 
 /*
-    @param  A const lvalue reference to the proces ID.
-    @return An iterator in the allProcesses_ vector pointing to the location of the process.
+    @post   Removes the processes and threads that are no longer in the process table from the wait list of every message queue,
+            dropping the messages that were handed to them.
+*/
+void SimOS::removeReleasedProcessesFromMessageQueues()
+{
+    for (CopyOnWrite<MessageQueue>& queue : messageQueues_)
+        queue.write().removeProcesses([this](const int& processID) { return !processes_.contains(processID); });
+}
+
+/*
+    @post   Drops the pending volume reads of processes and threads that are no longer in the process table.
+*/
+void SimOS::removeReleasedProcessesFromVolumes()
+{
+    for (CopyOnWrite<Volume>& volume : volumes_)
+        volume.write().removeProcesses([this](const int& processID) { return !processes_.contains(processID); });
+}
+
+/*
+    @param  A const lvalue reference to the number of the disk.
+    @param  A const lvalue reference to the ID of the name of the file.
+    @param  A const lvalue reference to the cylinder the file is on.
+
+    @note   If a disk with the requested number, the file name ID or the cylinder doesn’t exist throw std::out_of_range exception.
+*/
+void SimOS::checkDiskRead(const int& diskNumber, const int& fileNameID, const unsigned long long& cylinder) const
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    else if (fileNameID < 0 || static_cast<std::size_t>(fileNameID) >= fileNames_->size())
+        throw std::out_of_range("There is no file name with this ID");
+    else if (cylinder >= DEFAULT_DISK_CYLINDERS)
+        throw std::out_of_range("The cylinder is past the end of the disk");
+}
+
+/*
+    @post   Drops the pending file system reads of processes and threads that are no longer in the process table.
+*/
+void SimOS::removeReleasedProcessesFromFileSystems()
+{
+    for (CopyOnWrite<FileSystem>& fileSystem : fileSystems_)
+        fileSystem.write().removeProcesses([this](const int& processID) { return !processes_.contains(processID); });
+}
+
+/*
+    @param  A const lvalue reference to the number of the disk.
+    @param  A const lvalue reference to the name of a file.
+    @return The ID of the name of the file.
+
+    @note   If a disk with the requested number or the file on it doesn’t exist throw std::out_of_range exception.
+*/
+int SimOS::findFile(const int& diskNumber, const std::string& fileName) const
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    int fileNameID = fileNames_->find(fileName);
+    if (fileNameID < 0 || !fileSystems_[diskNumber]->contains(fileNameID))
+        throw std::out_of_range("There is no file with this name on the disk");
+    return fileNameID;
+}
+
+/*
+    @param  A const lvalue reference to the numbers of disks for a volume or replica set.
+
+    @note   If a disk with one of the numbers doesn’t exist throw std::out_of_range exception.
+    @note   If a disk is listed twice throw std::invalid_argument exception.
 */
-std::vector<Process>::iterator SimOS::findProcessByID(const int &processID)
+void SimOS::checkDistinctDisks(const std::vector<int>& diskNumbers) const
 {
-    std::vector<Process>::iterator iteratorToProcess = allProcesses_.begin();
-    for (iteratorToProcess; iteratorToProcess != allProcesses_.end(); iteratorToProcess++)
+    for (const int& diskNumber : diskNumbers)
     {
-        if (iteratorToProcess->getProcessID() == processID)
-            break;
+        if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+            throw std::out_of_range("The disk with the requested number does not exist");
     }
-        
-    return iteratorToProcess;
+    std::vector<int> distinctDisks = diskNumbers;
+    std::sort(distinctDisks.begin(), distinctDisks.end());
+    if (std::adjacent_find(distinctDisks.begin(), distinctDisks.end()) != distinctDisks.end())
+        throw std::invalid_argument("A disk can be listed only once");
+}
+
+/*
+    @param  A const lvalue reference to a request as a disk keeps it.
+    @return The request with the name of its file, as SimOS reports it.
+*/
+FileReadRequest SimOS::toFileReadRequest(const DiskRequest& request) const
+{
+    return FileReadRequest{request.PID, fileNames_->getName(request.fileNameID), request.cylinder, request.arrivalTime, request.blockCount};
+}
+
+/*
+    @post   Terminates the zombie child of the running process that exited first, which removes it from the process table.
+            Zombies released their memory when they exited, so there is nothing left to clear.
+    @return True if found and terminated a zombie, false otherwise
+*/
+bool SimOS::findZombieProcessAndTerminateIt()
+{
+    //Zombie children are queued at the front of the children, so the first one is found without a search
+    int zombieProcess = processes_.getFirstZombieChild(cpu_->getCurrentProcessID());
+    if(zombieProcess == NO_PROCESS)
+        return false;
+
+    processes_.setProcessState(zombieProcess, TERMINATED);
+    processes_.release(zombieProcess);
+    return true;
 }
 
 /*
@@ -375,16 +1400,24 @@ std::vector<Process>::iterator SimOS::findProcessByID(const int &processID)
 */
 void SimOS::findAndRemoveZombiesOrTerminatedProcesses()
 {
-    std::deque<int> origReadyQueue = cpu_.getReadyQueue();
-    std::deque<int> SanitizedReadyQueue;
-    for(int i = 0; i < origReadyQueue.size(); i++)
+    cpu_.write().removeFromReadyQueue([this](const int& pid)
     {
-        int pid = origReadyQueue.front();
-        if(allProcesses_[pid].getProcessState() == READY && allProcesses_[pid].getProcessType() != ZOMBIE)
-        {
-            SanitizedReadyQueue.push_back(pid);
-        }
-        origReadyQueue.pop_front();
+        return !processes_.contains(pid) || processes_.getProcessState(pid) != READY || processes_.getProcessType(pid) == ZOMBIE;
+    });
+}
+/*
+    @param  A const lvalue reference to the ID of the process that was running when the timer interrupt arrived.
+    @param  A const lvalue reference to the PID and state of the process running after the interrupt.
+    @post   The records of the new current process, the interrupted process and every real-time process the interrupt woke up reflect their new states.
+*/
+void SimOS::updateInterruptedProcesses(const int& interruptedProcess, const std::pair<int, int>& newCurrentProcess)
+{
+    processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);   //Update the new current process's information in the record
+    if(newCurrentProcess.first != interruptedProcess)   //If the interrupted process was sent to the ready queue or finished its real-time job, update it's state in the record to reflect this
+        processes_.setProcessState(interruptedProcess, cpu_->isWaitingForRelease(interruptedProcess) ? WAITING : READY);
+    for (int releasedProcess : cpu_->getReleasedProcesses())
+    {
+        if (releasedProcess != newCurrentProcess.first)
+            processes_.setProcessState(releasedProcess, READY);
     }
-    cpu_.setReadyQueue(SanitizedReadyQueue);
-}
\ No newline at end of file
+}
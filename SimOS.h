@@ -3,42 +3,411 @@
 #define SIMOS_H
 #include <vector>
 #include <deque>
+#include <stdexcept>
 #include "./components/CPUManager.h"
 #include "./components/DiskManager.h"
 #include "./components/MemoryManager.h"
 #include "./components/Process.h"
+#include "./components/ProcessTable.h"
+#include "./components/MessageQueue.h"
+#include "./components/FileNameTable.h"
+#include "./components/Volume.h"
+#include "./components/ReplicaSet.h"
+#include "./components/FileSystem.h"
+#include "./components/Checkpoint.h"
+#include "./components/CopyOnWrite.h"
 
 class SimOS
 {
 public:
     SimOS(int numberOfDisks, unsigned long long amountOfRAM, unsigned int pageSize);
     void NewProcess();
+    bool NewProcess(unsigned long long period, unsigned long long relativeDeadline, unsigned long long budget);
     void SimFork();
+    std::pair<int, int> NewProcesses(unsigned int count);
+    std::pair<int, int> SimForkN(unsigned int count);
+    int NewThread();
     void SimExit();
     void SimWait();
     void TimerInterrupt();
-    void DiskReadRequest(int diskNumber, std::string fileName);
+    void TimerInterrupt(unsigned long long count);
+    void DiskReadRequest(int diskNumber, const std::string& fileName);
+    void DiskReadRequest(int diskNumber, const std::string& fileName, unsigned long long cylinder);
+    void DiskReadRequest(int diskNumber, int fileNameID, unsigned long long cylinder);
+    int InternFileName(const std::string& fileName);
+    unsigned int SubmitDiskReads(const std::vector<DiskSubmission>& submissions);
+    std::vector<DiskCompletion> CompleteDiskJobs(const std::vector<int>& diskNumbers);
     void DiskJobCompleted(int diskNumber);
+    void DiskJobCompleted(int diskNumber, unsigned int slot);
     void AccessMemoryAddress(unsigned long long address);
+    int CreateSharedMemory(unsigned long long size);
+    void AttachSharedMemory(int segmentID, unsigned long long address);
+    void DetachSharedMemory(int segmentID);
+    int CreateMessageQueue(unsigned int capacity);
+    bool SendMessage(int queueNumber, unsigned long long handle);
+    Message ReceiveMessage(int queueNumber);
+    MessageQueueStats GetMessageQueueStats(int queueNumber);
     int GetCPU();
     std::deque<int> GetReadyQueue();
     MemoryUsage GetMemory();
     FileReadRequest GetDisk(int diskNumber);
+    FileReadRequest GetDisk(int diskNumber, unsigned int slot);
     std::deque<FileReadRequest> GetDiskQueue(int diskNumber);
+    DiskSeekStats GetDiskSeekStats(int diskNumber);
+    void SetDiskServiceModel(int diskNumber, DiskServiceModel serviceModel);
+    DiskReport GetDiskReport(int diskNumber);
+    void SetDiskParallelism(int diskNumber, unsigned int hardwareQueues, unsigned int slots);
+    int CreateVolume(int level, std::vector<int> diskNumbers);
+    void VolumeReadRequest(int volumeNumber, const std::string& fileName, unsigned long long block, unsigned int blockCount);
+    void VolumeReadRequest(int volumeNumber, int fileNameID, unsigned long long block, unsigned int blockCount);
+    void FailVolumeDisk(int volumeNumber, unsigned int member);
+    VolumeStats GetVolumeStats(int volumeNumber);
+    int CreateReplicaSet(int placement, std::vector<int> diskNumbers);
+    int ReplicaReadRequest(int replicaSetNumber, const std::string& fileName, unsigned long long cylinder);
+    int ReplicaReadRequest(int replicaSetNumber, int fileNameID, unsigned long long cylinder);
+    ReplicaSetStats GetReplicaSetStats(int replicaSetNumber);
+    void CreateFile(int diskNumber, const std::string& fileName, unsigned long long sizeInBlocks);
+    void DeleteFile(int diskNumber, const std::string& fileName);
+    std::vector<Extent> GetFileExtents(int diskNumber, const std::string& fileName);
+    void ReadFile(int diskNumber, const std::string& fileName);
+    void ReadFile(int diskNumber, const std::string& fileName, unsigned long long firstBlock, unsigned long long blockCount);
+    FileSystemStats GetFileSystemStats(int diskNumber);
+    void SetFileCache(bool enabled);
+    FileCacheStats GetFileCacheStats();
+    std::vector<int> GetThreads(int processID);
+    SchedulingSummary GetSchedulingStats();
+    ProcessMetrics GetProcessMetrics(int processID);
+    void SetTimeQuantum(unsigned long long timeQuantum);
+    void SetContextSwitchCost(unsigned long long switchOverhead, unsigned long long warmupPenalty, unsigned long long warmthWindow);
+    ContextSwitchReport GetContextSwitchReport();
+    RealTimeReport GetRealTimeReport();
+    void SetProcessIDRecycling(bool recycling);
+    void SaveCheckpoint(std::string path);
+    void LoadCheckpoint(std::string path);
+    SimOS Clone() const;
 
     //Helper functions
     bool findParentProcessAndResumeIt(const int& parentProcessID);
-    void findChildrenProcessesAndTerminateThem(const int& currProcessID);
+    void findChildrenProcessesAndTerminateThem(const int& currProcessID, std::vector<int>& terminated);
     bool findZombieProcessAndTerminateIt();
-    std::vector<Process>::iterator findProcess(const Process& process);
-    std::vector<Process>::iterator findProcessByID(const int& processID);
     void findAndRemoveZombiesOrTerminatedProcesses();
-private:
-    CPUManager cpu_;
-    std::vector<DiskManager> disks_;
-    MemoryManager ram_;
+    bool findThreadsAndTerminateThem(const int& processID, std::vector<int>& terminated);
+    void cancelDiskRequests(const std::vector<int>& terminated);
+    void removeReleasedProcessesFromMessageQueues();
+    void removeReleasedProcessesFromVolumes();
+    void removeReleasedProcessesFromFileSystems();
+    FileReadRequest toFileReadRequest(const DiskRequest& request) const;
+protected:
+    //Policy-parameterized forms of the hot paths, used with the default policies by the functions above and with any policies by PolicySimOS
+    template <class Scheduler>
+    void timerInterruptWith(const Scheduler& scheduler);
+    template <class Scheduler>
+    void timerInterruptsWith(const Scheduler& scheduler, const unsigned long long& count);
+    template <class Replacement>
+    void accessMemoryAddressWith(const Replacement& replacement, const unsigned long long& address);
+    template <class Replacement>
+    void diskReadRequestWith(const Replacement& replacement, const int& diskNumber, const int& fileNameID, const unsigned long long& cylinder);
+    template <class Replacement>
+    unsigned int submitDiskReadsWith(const Replacement& replacement, const std::vector<DiskSubmission>& submissions);
+    template <class Replacement>
+    bool issueDiskRead(const Replacement& replacement, const DiskSubmission& submission);
+    void checkDiskRead(const int& diskNumber, const int& fileNameID, const unsigned long long& cylinder) const;
+    void checkDistinctDisks(const std::vector<int>& diskNumbers) const;
+    int findFile(const int& diskNumber, const std::string& fileName) const;
+    template <class Replacement>
+    int replicaReadRequestWith(const Replacement& replacement, const int& replicaSetNumber, const int& fileNameID, const unsigned long long& cylinder);
+    template <class DiskPolicy>
+    void diskJobCompletedWith(const DiskPolicy& diskPolicy, const int& diskNumber);
+    template <class DiskPolicy>
+    void diskJobCompletedWith(const DiskPolicy& diskPolicy, const int& diskNumber, const unsigned int& slot);
+    template <class DiskPolicy>
+    std::vector<DiskCompletion> completeDiskJobsWith(const DiskPolicy& diskPolicy, const std::vector<int>& diskNumbers);
+    template <class DiskPolicy>
+    DiskRequest finishDiskJob(const DiskPolicy& diskPolicy, const int& diskNumber, const unsigned int& slot);
+    void updateInterruptedProcesses(const int& interruptedProcess, const std::pair<int, int>& newCurrentProcess);
 
-    std::vector<Process> allProcesses_;
-    std::vector<Process> waitingProcesses_;
+    //Shared with clones until changed, see Clone()
+    CopyOnWrite<CPUManager> cpu_;
+    std::vector<CopyOnWrite<DiskManager>> disks_;
+    std::vector<CopyOnWrite<FileSystem>> fileSystems_;      //One per disk
+    CopyOnWrite<MemoryManager> ram_;
+    std::vector<CopyOnWrite<MessageQueue>> messageQueues_;
+    std::vector<CopyOnWrite<Volume>> volumes_;
+    std::vector<CopyOnWrite<ReplicaSet>> replicaSets_;
+    CopyOnWrite<FileNameTable> fileNames_;
+
+    ProcessTable processes_;
+    std::vector<int> terminated_;   //Processes and threads the current exit terminated, cleared but not freed between exits
 };
+
+/*
+    @param  A const lvalue reference to the scheduling policy of the ready queue.
+    @post   Same as TimerInterrupt(), with the policy deciding whether the running process is preempted.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+template <class Scheduler>
+void SimOS::timerInterruptWith(const Scheduler& scheduler)
+{
+    if (cpu_->isBusy())
+    {
+        int interruptedProcess = cpu_->getCurrentProcessID();
+        updateInterruptedProcesses(interruptedProcess, cpu_.write().timerInterrupt(scheduler));
+    }
+    else
+        throw std::logic_error("This instruction requires a running process");
+}
+
+/*
+    @param  A const lvalue reference to the scheduling policy of the ready queue.
+    @param  The number of timer interrupts to apply.
+    @post   Same as TimerInterrupt(count), with the policy deciding whether the running process is preempted.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+template <class Scheduler>
+void SimOS::timerInterruptsWith(const Scheduler& scheduler, const unsigned long long& count)
+{
+    if (cpu_->isBusy())
+    {
+        if (cpu_->hasRealTimeProcesses())
+        {
+            for (unsigned long long i = 0; i < count && cpu_->isBusy(); i++)
+                timerInterruptWith(scheduler);  //Releases and budgets change the rotation every quantum, so the states need updating one interrupt at a time
+            return;
+        }
+
+        int interruptedProcess = cpu_->getCurrentProcessID();
+        std::pair<int, int> newCurrentProcess = cpu_.write().timerInterrupt(scheduler, count);
+        processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);
+        if (newCurrentProcess.first != interruptedProcess)
+            processes_.setProcessState(interruptedProcess, READY);
+    }
+    else
+        throw std::logic_error("This instruction requires a running process");
+}
+
+/*
+    @param  A const lvalue reference to the page replacement policy.
+    @param  The logical address in RAM.
+    @post   Same as AccessMemoryAddress(address), with the policy deciding how a hit updates the "recently used" information.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+*/
+template <class Replacement>
+void SimOS::accessMemoryAddressWith(const Replacement& replacement, const unsigned long long& address)
+{
+    if (cpu_->isBusy())
+    {
+        int runningProcess = cpu_->getCurrentProcessID();
+        bool pageFault = ram_.write().accessMemoryAtAddress(replacement, processes_.getOwnerProcessID(runningProcess), address);
+        cpu_.write().recordMemoryAccess(runningProcess, pageFault);
+    }
+    else
+        throw std::logic_error("This instruction requires a running process");
+}
+
+/*
+    @param  A const lvalue reference to the page replacement policy.
+    @param  A const lvalue reference to the number of the disk that contains the file to be read.
+    @param  A const lvalue reference to the ID of the name of the file to be read, from InternFileName().
+    @param  A const lvalue reference to the cylinder the file is on.
+    @post   Same as DiskReadRequest(diskNumber, fileNameID, cylinder), with the policy deciding how a file block cache hit updates the "recently used" information.
+
+    @note   If a disk with the requested number, the file name ID or the cylinder doesn’t exist throw std::out_of_range exception.
+*/
+template <class Replacement>
+void SimOS::diskReadRequestWith(const Replacement& replacement, const int& diskNumber, const int& fileNameID, const unsigned long long& cylinder)
+{
+    checkDiskRead(diskNumber, fileNameID, cylinder);
+    if (issueDiskRead(replacement, DiskSubmission{diskNumber, fileNameID, cylinder}))
+    {
+        std::pair<int, int> newCurrentProcess = cpu_.write().runFirstProcess();
+        processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);
+    }
+}
+
+/*
+    @param  A const lvalue reference to the page replacement policy.
+    @param  A const lvalue reference to the number of the replica set that holds the file.
+    @param  A const lvalue reference to the ID of the name of the file to be read, from InternFileName().
+    @param  A const lvalue reference to the cylinder the file is on.
+    @post   Same as ReplicaReadRequest(replicaSetNumber, fileNameID, cylinder), with the policy deciding how a file block cache hit updates the "recently used" information.
+    @return The number of the disk the read was placed on.
+
+    @note   If instruction is called that requires a running process, but the CPU is idle, throw std::logic_error exception.
+    @note   If a replica set with the requested number, the file name ID or the cylinder doesn’t exist throw std::out_of_range exception.
+*/
+template <class Replacement>
+int SimOS::replicaReadRequestWith(const Replacement& replacement, const int& replicaSetNumber, const int& fileNameID, const unsigned long long& cylinder)
+{
+    if (!cpu_->isBusy())
+        throw std::logic_error("This instruction requires a running process");
+    else if (replicaSetNumber < 0 || static_cast<std::size_t>(replicaSetNumber) >= replicaSets_.size())
+        throw std::out_of_range("The replica set with the requested number does not exist");
+    checkDiskRead(replicaSets_[replicaSetNumber]->getDisks().front(), fileNameID, cylinder);
+
+    int diskNumber = replicaSets_[replicaSetNumber].write().place(cpu_->getCurrentProcessID(), [this](const int& replica) { return disks_[replica]->getLoad(); });
+    diskReadRequestWith(replacement, diskNumber, fileNameID, cylinder);
+    return diskNumber;
+}
+
+/*
+    @param  A const lvalue reference to the page replacement policy.
+    @param  A const lvalue reference to the submissions, in order.
+    @post   Same as SubmitDiskReads(submissions), with the policy deciding how a file block cache hit updates the "recently used" information.
+    @return The number of submissions made.
+
+    @note   If any submission names a disk, file name ID or cylinder that doesn’t exist throw std::out_of_range exception, before any submission is made.
+*/
+template <class Replacement>
+unsigned int SimOS::submitDiskReadsWith(const Replacement& replacement, const std::vector<DiskSubmission>& submissions)
+{
+    for (const DiskSubmission& submission : submissions)
+        checkDiskRead(submission.diskNumber, submission.fileNameID, submission.cylinder);
+
+    unsigned int submitted{0};
+    std::pair<int, int> newCurrentProcess{NO_PROCESS, NO_PROCESS};
+    bool dispatched{false};
+    for (const DiskSubmission& submission : submissions)
+    {
+        if (!cpu_->isBusy())
+            break;
+        if (issueDiskRead(replacement, submission))
+        {
+            //The processes dispatched in between issue the next submissions right away, so only the last dispatch needs its state recorded
+            newCurrentProcess = cpu_.write().runFirstProcess();
+            dispatched = true;
+        }
+        submitted++;
+    }
+    if (dispatched)
+        processes_.setProcessState(newCurrentProcess.first, newCurrentProcess.second);
+    return submitted;
+}
+
+/*
+    @param  A const lvalue reference to the page replacement policy.
+    @param  A const lvalue reference to a checked submission.
+    @post   The running process reads the file. On a file block cache hit, the hit is credited with the requests at the disk and the time
+            the disk's slots would have taken to serve them at its mean service time, and the process keeps the CPU. Otherwise the request joins the disk, and the process is blocked (WAITING) and taken off the CPU.
+            The caller dispatches the next process.
+    @return True if the process blocked, false if the read was a cache hit.
+*/
+template <class Replacement>
+bool SimOS::issueDiskRead(const Replacement& replacement, const DiskSubmission& submission)
+{
+    if (ram_->isFileCacheEnabled() && ram_.write().readFileBlock(replacement, submission.diskNumber, submission.fileNameID))
+    {
+        unsigned long long requestsSkipped = disks_[submission.diskNumber]->getQueueDepth();
+        unsigned long long slots = disks_[submission.diskNumber]->getSlotCount();
+        ram_.write().recordTimeSaved(requestsSkipped, (requestsSkipped / slots + 1) * disks_[submission.diskNumber]->getMeanServiceTime());
+        return false;
+    }
+    DiskRequest newRequest{cpu_->getCurrentProcessID(), submission.fileNameID, submission.cylinder, cpu_->getCurrentTime()};
+    disks_[submission.diskNumber].write().addToQueue(newRequest);
+    processes_.setProcessState(newRequest.PID, WAITING);
+    cpu_.write().recordBlocked(newRequest.PID, true);
+    return true;
+}
+
+/*
+    @param  A const lvalue reference to the disk scheduling policy.
+    @param  The number of the disk.
+    @post   Same as DiskJobCompleted(diskNumber), with the policy choosing the request the disk serves next.
+            A process that was terminated while its request was queued doesn't return to the ready-queue.
+
+    @note   If a disk with the requested number doesn’t exist throw std::out_of_range exception.
+*/
+template <class DiskPolicy>
+void SimOS::diskJobCompletedWith(const DiskPolicy& diskPolicy, const int& diskNumber)
+{
+    if (diskNumber >= disks_.size() || diskNumber < 0)
+        throw std::out_of_range("The disk with the requested number does not exist");
+    else
+        finishDiskJob(diskPolicy, diskNumber, disks_[diskNumber]->getOldestSlot());
+}
+
+/*
+    @param  A const lvalue reference to the disk scheduling policy.
+    @param  The number of the disk.
+    @param  The in-flight slot whose job completed.
+    @post   Same as DiskJobCompleted(diskNumber, slot), with the policy choosing the request the slot serves next.
+
+    @note   If a disk with the requested number or the slot doesn’t exist throw std::out_of_range exception.
+*/
+template <class DiskPolicy>
+void SimOS::diskJobCompletedWith(const DiskPolicy& diskPolicy, const int& diskNumber, const unsigned int& slot)
+{
+    if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+        throw std::out_of_range("The disk with the requested number does not exist");
+    else if (slot >= disks_[diskNumber]->getSlotCount())
+        throw std::out_of_range("The disk has no slot with this number");
+    else
+        finishDiskJob(diskPolicy, diskNumber, slot);
+}
+
+/*
+    @param  A const lvalue reference to the disk scheduling policy.
+    @param  A const lvalue reference to the disk numbers, one per completed job, in order.
+    @post   Same as CompleteDiskJobs(diskNumbers), with the policy choosing the requests the disks serve next.
+    @return A completion for every job that was finished, in order.
+
+    @note   If any disk number doesn’t exist throw std::out_of_range exception, before any job is completed.
+*/
+template <class DiskPolicy>
+std::vector<DiskCompletion> SimOS::completeDiskJobsWith(const DiskPolicy& diskPolicy, const std::vector<int>& diskNumbers)
+{
+    for (const int& diskNumber : diskNumbers)
+    {
+        if (diskNumber < 0 || static_cast<std::size_t>(diskNumber) >= disks_.size())
+            throw std::out_of_range("The disk with the requested number does not exist");
+    }
+
+    std::vector<DiskCompletion> completions;
+    completions.reserve(diskNumbers.size());
+    for (const int& diskNumber : diskNumbers)
+    {
+        unsigned int slot = disks_[diskNumber]->getOldestSlot();
+        DiskRequest finished = finishDiskJob(diskPolicy, diskNumber, slot);
+        if (finished.PID != NO_PROCESS)
+            completions.push_back(DiskCompletion{diskNumber, slot, finished.PID, finished.fileNameID});
+    }
+    return completions;
+}
+
+/*
+    @param  A const lvalue reference to the disk scheduling policy.
+    @param  A const lvalue reference to the number of an existing disk.
+    @param  A const lvalue reference to the number of an existing slot of the disk.
+    @post   The slot finishes its job: the file is cached if the file block cache is on, and the process returns to the ready-queue
+            unless it was terminated in the meantime or the job is one of several requests of a file system or volume read that has others left.
+            The policy chooses the request the slot serves next.
+    @return The finished request, or the default DiskRequest if the slot was free.
+*/
+template <class DiskPolicy>
+DiskRequest SimOS::finishDiskJob(const DiskPolicy& diskPolicy, const int& diskNumber, const unsigned int& slot)
+{
+    DiskRequest finished = disks_[diskNumber]->getDiskRequest(slot);
+    if (finished.PID != NO_PROCESS && ram_->isFileCacheEnabled())
+        ram_.write().cacheFileBlock(diskNumber, finished.fileNameID);
+    bool readDone{true};
+    if (finished.PID != NO_PROCESS && fileSystems_[diskNumber]->isPending(finished.PID))
+        readDone = fileSystems_[diskNumber].write().finishRequest(finished.PID);
+    for (CopyOnWrite<Volume>& volume : volumes_)
+    {
+        if (finished.PID != NO_PROCESS && volume->isPending(finished.PID))
+        {
+            readDone = volume.write().finishSubrequest(finished.PID, cpu_->getCurrentTime());
+            break;
+        }
+    }
+    if (readDone && finished.PID != NO_PROCESS && processes_.contains(finished.PID) && processes_.getProcessState(finished.PID) == WAITING)
+    {
+        cpu_.write().recordUnblocked(finished.PID);
+        processes_.setProcessState(finished.PID, cpu_.write().addProcess(finished.PID));
+    }
+    disks_[diskNumber].write().serveNextProcess(diskPolicy, slot, cpu_->getCurrentTime());
+    return finished;
+}
 #endif
\ No newline at end of file
@@ -0,0 +1,335 @@
+#include "SimOS.h"
+#include "SimOS.cpp"
+#include "PolicySimOS.h"
+#include "./components/CPUManager.h"
+#include "./components/CPUManager.cpp"
+#include "./components/DiskManager.h"
+#include "./components/DiskManager.cpp"
+#include "./components/MemoryManager.h"
+#include "./components/MemoryManager.cpp"
+#include "./components/Process.h"
+#include "./components/Process.cpp"
+#include "./components/ProcessTable.h"
+#include "./components/ProcessTable.cpp"
+#include "./components/Histogram.h"
+#include "./components/Histogram.cpp"
+#include "./components/SchedulingStats.h"
+#include "./components/SchedulingStats.cpp"
+#include "./components/EDFScheduler.h"
+#include "./components/EDFScheduler.cpp"
+#include "./components/Checkpoint.h"
+#include "./components/Checkpoint.cpp"
+#include "./components/MessageQueue.h"
+#include "./components/MessageQueue.cpp"
+#include "./components/FileNameTable.h"
+#include "./components/FileNameTable.cpp"
+#include "./components/Volume.h"
+#include "./components/Volume.cpp"
+#include "./components/ReplicaSet.h"
+#include "./components/ReplicaSet.cpp"
+#include "./components/FileSystem.h"
+#include "./components/FileSystem.cpp"
+#include "./components/DynamicPolicies.h"
+#include <chrono>
+#include <iostream>
+
+constexpr int BENCHMARK_PROCESSES{8};
+constexpr unsigned long long BENCHMARK_ROUNDS{1000000};
+constexpr int BENCHMARK_REPETITIONS{5};
+
+/*
+    @param  A simulator with no processes.
+    @post   Runs the same mix of timer interrupts, memory accesses and disk jobs on the simulator.
+    @return The time the mix took, in nanoseconds per round.
+*/
+template <class Simulator>
+double runWorkload(Simulator& sim)
+{
+    for (int i = 0; i < BENCHMARK_PROCESSES; i++)
+        sim.NewProcess();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned long long round = 0; round < BENCHMARK_ROUNDS; round++)
+    {
+        sim.AccessMemoryAddress((round * 7919) % 320);
+        sim.TimerInterrupt();
+        if (round % 16 == 0)
+        {
+            sim.DiskReadRequest(0, "file.txt");
+            sim.DiskJobCompleted(0);
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / BENCHMARK_ROUNDS;
+}
+
+/*
+    @param  The arguments every fresh simulator is constructed with.
+    @return The best time per round over several runs, each on a fresh simulator.
+*/
+template <class Simulator, class... Arguments>
+double bestOf(const Arguments&... arguments)
+{
+    double best{0};
+    for (int i = 0; i < BENCHMARK_REPETITIONS; i++)
+    {
+        Simulator sim{arguments...};
+        double time = runWorkload(sim);
+        if (i == 0 || time < best)
+            best = time;
+    }
+    return best;
+}
+
+/*
+    @param  The number of processes to start.
+    @return The milliseconds it takes to start the processes one NewProcess() call at a time and with one NewProcesses() call.
+*/
+std::pair<double, double> timeSetup(const unsigned int& count)
+{
+    SimOS oneByOne{1, 160, 10};
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < count; i++)
+        oneByOne.NewProcess();
+    std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+
+    SimOS inBulk{1, 160, 10};
+    inBulk.NewProcesses(count);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return std::make_pair(std::chrono::duration<double, std::milli>(middle - start).count(), std::chrono::duration<double, std::milli>(end - middle).count());
+}
+
+/*
+    @param  The number of processes in the warmed-up simulation.
+    @param  The number of what-if variants to branch from it.
+    @return The microseconds it takes on average to clone the simulation and run one timer interrupt and one memory access on the clone.
+*/
+double timeClones(const unsigned int& count, const unsigned int& variants)
+{
+    SimOS warmedUp{1, 160, 10};
+    warmedUp.NewProcesses(count);
+    std::vector<SimOS> clones;
+    clones.reserve(variants);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < variants; i++)
+    {
+        clones.push_back(warmedUp.Clone());
+        clones.back().TimerInterrupt();
+        clones.back().AccessMemoryAddress(i * 10);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / variants;
+}
+
+/*
+    @param  The number of disk reads to queue and serve.
+    @return The nanoseconds per read it takes to queue and serve the reads by file name and by interned file name ID.
+*/
+std::pair<double, double> timeDiskReads(const unsigned int& count)
+{
+    const std::string fileName{"/var/log/simulated/a_file_name_too_long_for_the_small_string_buffer.log"};
+    std::pair<double, double> times;
+    for (int byID = 0; byID < 2; byID++)
+    {
+        SimOS sim{1, 160, 10};
+        sim.NewProcesses(64);
+        int fileNameID = sim.InternFileName(fileName);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < count; i++)
+        {
+            if (sim.GetCPU() == NO_PROCESS)
+                sim.DiskJobCompleted(0);
+            else if (byID)
+                sim.DiskReadRequest(0, fileNameID, 0);
+            else
+                sim.DiskReadRequest(0, fileName);
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        (byID ? times.second : times.first) = std::chrono::duration<double, std::nano>(end - start).count() / count;
+    }
+    return times;
+}
+
+/*
+    @param  A const lvalue reference to the number of reads.
+    @return The time per read, in nanoseconds, to queue and serve reads with 64 processes sharing one disk,
+            first one call per read and completion, then 64 reads and 64 completions per call.
+*/
+std::pair<double, double> timeBatchedDiskReads(const unsigned int& count)
+{
+    std::pair<double, double> times;
+    for (int batched = 0; batched < 2; batched++)
+    {
+        SimOS sim{1, 160, 10};
+        sim.NewProcesses(64);
+        int fileNameID = sim.InternFileName("batch.txt");
+        const std::vector<DiskSubmission> submissions(64, DiskSubmission{0, fileNameID, 0});
+        const std::vector<int> diskNumbers(64, 0);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned int done = 0; done < count; done += 64)
+        {
+            if (batched)
+            {
+                sim.SubmitDiskReads(submissions);
+                sim.CompleteDiskJobs(diskNumbers);
+            }
+            else
+            {
+                for (int i = 0; i < 64; i++)
+                    sim.DiskReadRequest(0, fileNameID, 0);
+                for (int i = 0; i < 64; i++)
+                    sim.DiskJobCompleted(0);
+            }
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        (batched ? times.second : times.first) = std::chrono::duration<double, std::nano>(end - start).count() / count;
+    }
+    return times;
+}
+
+/*
+    @param  The disk scheduling policy.
+    @return The mean distance the head travels per request when 64 processes keep one disk busy with reads from pseudo-random cylinders.
+            A process issues its next read as soon as it runs again, so the queue stays close to 63 requests deep.
+*/
+template <class DiskPolicy>
+double meanSeekDistance(const DiskPolicy& diskPolicy)
+{
+    PolicySimOS<RoundRobinScheduling, LRUReplacement, DiskPolicy> sim{1, 160ull, 10u, RoundRobinScheduling(), LRUReplacement(), diskPolicy};
+    sim.NewProcesses(64);
+    unsigned long long random{1};
+    for (unsigned long long round = 0; round < BENCHMARK_ROUNDS; round++)
+    {
+        if (sim.GetCPU() != NO_PROCESS)
+        {
+            random = random * 6364136223846793005ull + 1442695040888963407ull;
+            sim.DiskReadRequest(0, "file.txt", (random >> 33) % DEFAULT_DISK_CYLINDERS);
+        }
+        else
+            sim.DiskJobCompleted(0);
+    }
+    return sim.GetDiskSeekStats(0).meanSeekDistance;
+}
+
+/*
+    @param  A const lvalue reference to the placement mode of the replica set.
+    @return The stats of a replica set of three fast disks and a slow one that serves reads at a quarter of their rate, after 64 processes
+            made up to three reads per time quantum. Each disk finishes a job every time its service time passes.
+*/
+ReplicaSetStats placeReplicaReads(const int& placement)
+{
+    const unsigned long long serviceTimes[4]{1, 1, 1, 4};
+    SimOS sim{4, 160, 10};
+    sim.SetTimeQuantum(1);
+    for (int disk = 0; disk < 4; disk++)
+        sim.SetDiskServiceModel(disk, DiskServiceModel{0, 0, 0, 0, serviceTimes[disk]});
+    sim.NewProcesses(64);
+    int replicaSet = sim.CreateReplicaSet(placement, {0, 1, 2, 3});
+    int fileNameID = sim.InternFileName("replica.txt");
+    for (unsigned long long round = 1; round <= BENCHMARK_ROUNDS / 10; round++)
+    {
+        for (int read = 0; read < 3 && sim.GetCPU() != NO_PROCESS; read++)
+            sim.ReplicaReadRequest(replicaSet, fileNameID, 0);
+        if (sim.GetCPU() != NO_PROCESS)
+            sim.TimerInterrupt();
+        for (int disk = 0; disk < 4; disk++)
+        {
+            if (round % serviceTimes[disk] == 0)
+                sim.DiskJobCompleted(disk);
+        }
+    }
+    return sim.GetReplicaSetStats(replicaSet);
+}
+
+/*
+    @param  True to create the files on an aged disk, whose free space is holes of 8 blocks left by deleted files.
+    @return The disk busy time per block of reading 64 files of 256 blocks once each, one file at a time.
+            On a fresh disk every file is one extent; on the aged one it is 32, each costing a seek and a rotational delay.
+*/
+double busyTimePerBlock(const bool& aged)
+{
+    SimOS sim{1, 160, 10};
+    sim.SetDiskServiceModel(0, DiskServiceModel{2, 0.01, 4, 1, 0});
+    if (aged)
+    {
+        for (unsigned long long file = 0; file < DEFAULT_DISK_BLOCKS / 8; file++)
+            sim.CreateFile(0, "old" + std::to_string(file), 8);
+        for (unsigned long long file = 0; file < DEFAULT_DISK_BLOCKS / 8; file += 2)
+            sim.DeleteFile(0, "old" + std::to_string(file));
+    }
+    for (int file = 0; file < 64; file++)
+        sim.CreateFile(0, "new" + std::to_string(file), 256);
+    sim.NewProcess();
+    for (int file = 0; file < 64; file++)
+    {
+        sim.ReadFile(0, "new" + std::to_string(file));
+        while (sim.GetCPU() == NO_PROCESS)
+            sim.DiskJobCompleted(0);
+    }
+    return static_cast<double>(sim.GetDiskReport(0).busyTime) / sim.GetFileSystemStats(0).blocksRead;
+}
+
+int main()
+{
+    using TemplatedSimOS = PolicySimOS<RoundRobinScheduling, LRUReplacement, FCFSDiskScheduling>;
+    using DynamicSimOS = PolicySimOS<DynamicScheduling, DynamicReplacement, DynamicDiskScheduling>;
+
+    double templatedTime = bestOf<TemplatedSimOS>(1, 160ull, 10u);
+    double dynamicTime = bestOf<DynamicSimOS>(1, 160ull, 10u);
+    double facadeTime = bestOf<SimOS>(1, 160ull, 10u);
+
+    std::cout << "Round-robin, LRU, FCFS disk; best of " << BENCHMARK_REPETITIONS << " runs of " << BENCHMARK_ROUNDS << " rounds of one memory access and one timer interrupt, with a disk job every 16 rounds" << std::endl;
+    std::cout << "  Templated policies (PolicySimOS):      " << templatedTime << " ns/round" << std::endl;
+    std::cout << "  Virtual policies (Dynamic* policies):  " << dynamicTime << " ns/round" << std::endl;
+    std::cout << "  Default SimOS:                         " << facadeTime << " ns/round" << std::endl;
+
+    std::pair<double, double> setupTime = timeSetup(1000000);
+    std::cout << "Starting 1000000 processes" << std::endl;
+    std::cout << "  NewProcess() one at a time:            " << setupTime.first << " ms" << std::endl;
+    std::cout << "  NewProcesses(1000000):                 " << setupTime.second << " ms" << std::endl;
+
+    std::cout << "Branching 32 what-if variants from 1000000 processes" << std::endl;
+    std::cout << "  Clone() and one step per variant:      " << timeClones(1000000, 32) << " us" << std::endl;
+
+    std::pair<double, double> readTime = timeDiskReads(1000000);
+    std::cout << "Queuing and serving 1000000 disk reads of a long file name, up to 64 at a time" << std::endl;
+    std::cout << "  By file name:                          " << readTime.first << " ns/read" << std::endl;
+    std::cout << "  By interned file name ID:              " << readTime.second << " ns/read" << std::endl;
+
+    std::pair<double, double> batchTime = timeBatchedDiskReads(1000000);
+    std::cout << "Queuing and serving 1000000 disk reads, 64 processes at a time" << std::endl;
+    std::cout << "  One call per read:                     " << batchTime.first << " ns/read" << std::endl;
+    std::cout << "  64 reads per call:                     " << batchTime.second << " ns/read" << std::endl;
+
+    std::cout << "Reads of a replica set with one slow disk out of four, 64 processes; p99 response time and mean queue imbalance" << std::endl;
+    const std::pair<const char*, int> placements[3]{{"  Static placement:                      ", STATIC_PLACEMENT}, {"  Shortest queue:                        ", SHORTEST_QUEUE}, {"  Earliest completion:                   ", EARLIEST_COMPLETION}};
+    for (const std::pair<const char*, int>& placement : placements)
+    {
+        ReplicaSetStats stats = placeReplicaReads(placement.second);
+        std::cout << placement.first << stats.responseTime.p99 << " p99, " << stats.queueImbalance.mean << " requests apart" << std::endl;
+    }
+
+    std::cout << "Reading 64 files of 256 blocks, one file at a time" << std::endl;
+    std::cout << "  Fresh disk, one extent per file:       " << busyTimePerBlock(false) << " busy time/block" << std::endl;
+    std::cout << "  Aged disk, 32 extents per file:        " << busyTimePerBlock(true) << " busy time/block" << std::endl;
+
+    std::cout << "Mean seek distance over " << DEFAULT_DISK_CYLINDERS << " cylinders with up to 64 requests waiting" << std::endl;
+    std::cout << "  FCFS:                                  " << meanSeekDistance(FCFSDiskScheduling()) << " cylinders/request" << std::endl;
+    std::cout << "  SSTF:                                  " << meanSeekDistance(SSTFDiskScheduling()) << " cylinders/request" << std::endl;
+    std::cout << "  SCAN:                                  " << meanSeekDistance(SCANDiskScheduling()) << " cylinders/request" << std::endl;
+    std::cout << "  C-SCAN:                                " << meanSeekDistance(CSCANDiskScheduling()) << " cylinders/request" << std::endl;
+    std::cout << "  C-LOOK:                                " << meanSeekDistance(CLOOKDiskScheduling()) << " cylinders/request" << std::endl;
+
+    TemplatedSimOS templated{1, 160, 10};
+    DynamicSimOS dynamic{1, 160, 10};
+    runWorkload(templated);
+    runWorkload(dynamic);
+    if (templated.GetCPU() != dynamic.GetCPU() || templated.GetReadyQueue() != dynamic.GetReadyQueue() || templated.GetMemory().size() != dynamic.GetMemory().size())
+    {
+        std::cout << "The templated and virtual builds diverged!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
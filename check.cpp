@@ -8,8 +8,32 @@
 #include "./components/MemoryManager.cpp"
 #include "./components/Process.h"
 #include "./components/Process.cpp"
+#include "./components/ProcessTable.h"
+#include "./components/ProcessTable.cpp"
+#include "./components/Histogram.h"
+#include "./components/Histogram.cpp"
+#include "./components/SchedulingStats.h"
+#include "./components/SchedulingStats.cpp"
+#include "./components/EDFScheduler.h"
+#include "./components/EDFScheduler.cpp"
+#include "./components/Checkpoint.h"
+#include "./components/Checkpoint.cpp"
+#include "./components/MessageQueue.h"
+#include "./components/MessageQueue.cpp"
+#include "./components/FileNameTable.h"
+#include "./components/FileNameTable.cpp"
+#include "./components/Volume.h"
+#include "./components/Volume.cpp"
+#include "./components/ReplicaSet.h"
+#include "./components/ReplicaSet.cpp"
+#include "./components/FileSystem.h"
+#include "./components/FileSystem.cpp"
+#include "./components/DynamicPolicies.h"
+#include "PolicySimOS.h"
 #include <deque>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 
 int main()
 {
@@ -461,6 +485,551 @@ int main()
         []            []            []            []
     */
 
+    // Scheduling metrics: time advances by one quantum (DEFAULT_TIME_QUANTUM) per timer interrupt
+    SimOS statsOS{ 1, 1000, 10 };
+    statsOS.NewProcess();       // PID 1 runs at time 0
+    statsOS.NewProcess();       // PID 2 waits in the ready queue
+    statsOS.TimerInterrupt();   // PID 2 runs at time 10
+    statsOS.TimerInterrupt();   // PID 1 runs at time 20
+    statsOS.SimExit();          // PID 1 completes at time 20
+    ProcessMetrics metrics{ statsOS.GetProcessMetrics(1) };
+    assert(metrics.hasCompleted && metrics.completionTime == 2 * DEFAULT_TIME_QUANTUM);
+    assert(metrics.cpuQuanta == 1 && metrics.readyWaitTime == DEFAULT_TIME_QUANTUM && metrics.contextSwitches == 2);
+    metrics = statsOS.GetProcessMetrics(2);
+    assert(metrics.firstRunTime == DEFAULT_TIME_QUANTUM && metrics.cpuQuanta == 1 && !metrics.hasCompleted);
+    SchedulingSummary schedulingSummary{ statsOS.GetSchedulingStats() };
+    assert(schedulingSummary.completedProcesses == 1 && schedulingSummary.turnaroundTime.p50 == 2 * DEFAULT_TIME_QUANTUM);
+    assert(schedulingSummary.responseTime.count == 2 && schedulingSummary.responseTime.p99 == DEFAULT_TIME_QUANTUM);
+    std::cout << "Scheduling metrics: Passed - Turnaround, waiting and response times recorded." << std::endl;
+
+    // Context switch cost model: 2 units per switch plus up to 4 units of warm-up after 40 units away
+    SimOS switchOS{ 1, 1000, 10 };
+    switchOS.SetContextSwitchCost(2, 4, 40);
+    switchOS.NewProcess();      // PID 1 is cold: 2 + 4 units
+    switchOS.NewProcess();
+    switchOS.TimerInterrupt();  // PID 2 is cold: 2 + 4 units
+    switchOS.TimerInterrupt();  // PID 1 was away for 16 units: 2 + 1 units
+    ContextSwitchReport switchReport{ switchOS.GetContextSwitchReport() };
+    assert(switchReport.switches == 3 && switchReport.switchOverheadTime == 6 && switchReport.warmupTime == 9);
+    assert(switchReport.usefulTime == 2 * DEFAULT_TIME_QUANTUM && switchReport.efficiency < 1);
+    std::cout << "Context switch cost: Passed - Switch overhead and warm-up penalty charged." << std::endl;
+
+    // Earliest-deadline-first real-time class
+    SimOS realTimeOS{ 1, 1000, 10 };
+    realTimeOS.NewProcess();                                // PID 1 (round-robin) runs at time 0
+    assert(realTimeOS.NewProcess(40, 40, 10));              // PID 2 reserves a quarter of the CPU
+    assert(!realTimeOS.NewProcess(10, 10, 9));              // Would need more than the remaining CPU
+    assert(realTimeOS.GetReadyQueue().front() == 2);
+    realTimeOS.TimerInterrupt();                            // PID 2 preempts PID 1 at time 10
+    assert(realTimeOS.GetCPU() == 2 && realTimeOS.GetReadyQueue().front() == 1);
+    realTimeOS.TimerInterrupt();                            // PID 2 finishes its job at time 20 and sleeps
+    assert(realTimeOS.GetCPU() == 1 && realTimeOS.GetReadyQueue().empty());
+    realTimeOS.TimerInterrupt();
+    realTimeOS.TimerInterrupt();                            // PID 2's next job is released at time 40
+    assert(realTimeOS.GetCPU() == 2);
+    ProcessMetrics sleeperMetrics{ realTimeOS.GetProcessMetrics(2) };
+    assert(sleeperMetrics.childWaitTime == 20 && sleeperMetrics.readyWaitTime == 10);  // The sleep isn't counted as waiting in the ready queue
+    RealTimeReport realTimeReport{ realTimeOS.GetRealTimeReport() };
+    assert(realTimeReport.admittedProcesses == 1 && realTimeReport.rejectedProcesses == 1);
+    assert(realTimeReport.completedJobs == 1 && realTimeReport.deadlineMisses == 0 && realTimeReport.slack.p50 == 20);
+    std::cout << "Real-time scheduling: Passed - EDF jobs preempt, complete and sleep until their next release." << std::endl;
+
+    // Bulk timer advance
+    SimOS bulkOS{ 1, 1000, 10 };
+    for (int i = 0; i < 4; i++)
+        bulkOS.NewProcess();    // PID 1 runs, PIDs 2, 3 and 4 wait
+    bulkOS.TimerInterrupt(1000002);
+    assert(bulkOS.GetCPU() == 3);
+    assert(bulkOS.GetReadyQueue() == std::deque<int>({ 4, 1, 2 }));
+    assert(bulkOS.GetProcessMetrics(1).cpuQuanta == 250001 && bulkOS.GetProcessMetrics(3).cpuQuanta == 250000);
+    assert(bulkOS.GetContextSwitchReport().switches == 1000003);
+    std::cout << "Bulk timer interrupts: Passed - Ready-queue rotated arithmetically." << std::endl;
+
+    // Compile-time and run-time policy composition
+    auto checkPolicies = [](auto& policyOS)
+    {
+        for (int i = 0; i < 3; i++)
+            policyOS.NewProcess();  // PID 1 runs, PIDs 2 and 3 wait
+        policyOS.TimerInterrupt();
+        policyOS.TimerInterrupt(5);
+        assert(policyOS.GetCPU() == 1 && policyOS.GetReadyQueue() == std::deque<int>({ 2, 3 }));    // FCFS keeps the CPU
+
+        for (unsigned long long address : { 0, 10, 20, 0, 30 })
+            policyOS.AccessMemoryAddress(address);
+        bool pageZeroLoaded{ false };
+        for (const MemoryItem& item : policyOS.GetMemory())
+            pageZeroLoaded = pageZeroLoaded || item.pageNumber == 0;
+        assert(!pageZeroLoaded);    // FIFO replaces page 0 even though it was just used
+
+        policyOS.DiskReadRequest(0, "a");
+        policyOS.DiskReadRequest(0, "b");
+        policyOS.DiskReadRequest(0, "c");
+        policyOS.DiskJobCompleted(0);
+        assert(policyOS.GetCPU() == 1 && policyOS.GetDisk(0).PID == 3);   // LIFO serves the latest request first
+    };
+    PolicySimOS<FCFSScheduling, FIFOReplacement, LIFODiskScheduling> templatedOS{ 1, 30, 10 };
+    checkPolicies(templatedOS);
+    PolicySimOS<DynamicScheduling, DynamicReplacement, DynamicDiskScheduling> dynamicOS{ 1, 30, 10, DynamicScheduling(FCFSScheduling()), DynamicReplacement(FIFOReplacement()), DynamicDiskScheduling(LIFODiskScheduling()) };
+    checkPolicies(dynamicOS);
+    std::cout << "Policy composition: Passed - Templated and type-erased policies behave the same." << std::endl;
+
+    // Process table with generational PIDs
+    ProcessTable table;
+    int first = table.create(RUNNING);
+    int second = table.create(READY, CHILD, first);
+    int third = table.create(READY, CHILD, first);
+    assert(first == 1 && second == 2 && third == 3 && table.getChildProcesses(first) == std::vector<int>({ 2, 3 }));
+    table.release(second);
+    assert(!table.contains(second) && table.getFirstChild(first) == third && table.peekNextProcessID() == 4);
+    table.setRecycling(true);
+    table.release(third);
+    assert(table.create(NEW) == makeProcessID(3, 1) && table.getSlotCount() == 4);
+    assert(table.getProcessState(makeProcessID(3, 1)) == NEW && table.getProcessType(makeProcessID(3, 1)) == REGULAR);
+    assert(getProcessSlot(MAX_RECYCLED_PROCESS_SLOTS + 3) == MAX_RECYCLED_PROCESS_SLOTS + 3 && getProcessGeneration(MAX_RECYCLED_PROCESS_SLOTS + 3) == 0);   // Sequential PIDs go past the recycled slots
+    assert(makeProcessID(3, MAX_PROCESS_GENERATION) != MAX_RECYCLED_PROCESS_SLOTS + 3 && getProcessGeneration(makeProcessID(3, MAX_PROCESS_GENERATION)) == MAX_PROCESS_GENERATION);
+
+    SimOS recycleOS{ 1, 100, 10 };
+    recycleOS.SetProcessIDRecycling(true);
+    recycleOS.NewProcess();     // PID 1 forks, reaps and forks again
+    for (int generation = 0; generation <= MAX_PROCESS_GENERATION + 1; generation++)
+    {
+        recycleOS.SimFork();
+        recycleOS.TimerInterrupt();
+        int child = recycleOS.GetCPU();
+        assert(child == (generation <= MAX_PROCESS_GENERATION ? makeProcessID(2, generation) : 3));  // Slot 2 is retired once its generation would wrap
+        recycleOS.SimExit();
+        recycleOS.SimWait();
+    }
+    assert(recycleOS.GetCPU() == 1 && recycleOS.GetSchedulingStats().completedProcesses == MAX_PROCESS_GENERATION + 2);
+    std::cout << "Process table: Passed - Terminated entries are recycled under unique PIDs." << std::endl;
+
+    // Zombie queues and waiting flags
+    ProcessTable zombieTable;
+    int zombieParent = zombieTable.create(RUNNING);
+    int firstChild = zombieTable.create(READY, CHILD, zombieParent);
+    int middleChild = zombieTable.create(READY, CHILD, zombieParent);
+    int lastChild = zombieTable.create(READY, CHILD, zombieParent);
+    zombieTable.setProcessType(lastChild, ZOMBIE);
+    zombieTable.setProcessType(firstChild, ZOMBIE);
+    assert(zombieTable.getFirstZombieChild(zombieParent) == lastChild);     // Zombies are reaped in the order they exited
+    zombieTable.release(lastChild);
+    assert(zombieTable.getFirstZombieChild(zombieParent) == firstChild);
+    zombieTable.release(firstChild);
+    assert(zombieTable.getFirstZombieChild(zombieParent) == NO_PROCESS && zombieTable.getChildProcesses(zombieParent) == std::vector<int>({ middleChild }));
+
+    SimOS waitOS{ 1, 100, 10 };
+    waitOS.NewProcess();                    // PID 1
+    waitOS.SimFork();                       // PID 2
+    waitOS.DiskReadRequest(0, "file.txt");  // PID 1 waits for the disk, not for its child
+    waitOS.SimExit();                       // PID 2 becomes a zombie
+    assert(waitOS.GetCPU() == NO_PROCESS);
+    waitOS.DiskJobCompleted(0);
+    waitOS.SimWait();                       // Reaps PID 2 right away
+    assert(waitOS.GetCPU() == 1 && waitOS.GetReadyQueue().empty());
+    std::cout << "Zombie queues: Passed - Waiting parents and zombie children are found without searching." << std::endl;
+
+    // Cascading termination of a deep process tree
+    SimOS chainOS{ 1, 100, 10 };
+    chainOS.NewProcess();                       // PID 1 is the root of the chain
+    for (int depth = 0; depth < 100000; depth++)
+    {
+        chainOS.SimFork();                      // The child is the only ready process
+        chainOS.AccessMemoryAddress(depth * 10);
+        chainOS.DiskReadRequest(0, "file.txt"); // The parent waits on the disk, so the child runs
+    }
+    chainOS.DiskJobCompleted(0);                // PID 1 returns to the ready-queue
+    chainOS.DiskReadRequest(0, "file.txt");     // The leaf waits too, so PID 1 runs
+    assert(chainOS.GetCPU() == 1);
+    chainOS.SimExit();                          // Terminates 100000 descendants without recursion
+    assert(chainOS.GetCPU() == NO_PROCESS && chainOS.GetReadyQueue().empty());
+    assert(chainOS.GetDiskQueue(0).empty() && chainOS.GetMemory().empty());
+    assert(chainOS.GetSchedulingStats().completedProcesses == 100001);
+    std::cout << "Cascading termination: Passed - A 100000 deep process tree is torn down in bulk." << std::endl;
+
+    // Process child bookkeeping
+    Process parentRecord(1, RUNNING, PARENT);
+    for (int child = 2; child < 10; child++)
+        parentRecord.addChildProcessID(child);      // Spills past the inline buffer
+    parentRecord.removeChildProcessFromRecord(5);
+    Process copiedRecord(parentRecord);
+    assert(copiedRecord.getChildProcesses().size() == 7 && copiedRecord.getChildProcesses()[3] == 6);
+    Process movedRecord(2);
+    movedRecord = std::move(parentRecord);
+    assert(movedRecord.getChildProcesses().size() == 7 && parentRecord.getChildProcesses().empty());
+    Process smallRecord(3);
+    smallRecord.addChildProcessID(4);
+    smallRecord.addChildProcessID(5);
+    smallRecord.removeChildProcessFromRecord(5);    // Removes the matching child, not the first one
+    assert(smallRecord.getChildProcesses().size() == 1 && smallRecord.getChildProcesses()[0] == 4);
+    std::cout << "Process children: Passed - Children are copied, moved and removed correctly." << std::endl;
+
+    // Bulk process creation
+    SimOS bulkCreateOS{ 1, 100, 10 };
+    assert(bulkCreateOS.NewProcesses(4) == std::make_pair(1, 4));
+    assert(bulkCreateOS.GetCPU() == 1 && bulkCreateOS.GetReadyQueue() == std::deque<int>({ 2, 3, 4 }));
+    assert(bulkCreateOS.SimForkN(3) == std::make_pair(5, 7));
+    assert(bulkCreateOS.GetReadyQueue() == std::deque<int>({ 2, 3, 4, 5, 6, 7 }));
+    assert(bulkCreateOS.NewProcesses(100000) == std::make_pair(8, 100007));
+    bulkCreateOS.SimExit();     // Cascading termination reaches every forked child
+    assert(bulkCreateOS.GetCPU() == 2 && bulkCreateOS.GetReadyQueue().size() == 100002);
+    assert(bulkCreateOS.GetSchedulingStats().arrivedProcesses == 100007 && bulkCreateOS.GetSchedulingStats().completedProcesses == 4);
+    std::cout << "Bulk process creation: Passed - PID ranges are created and queued at once." << std::endl;
+
+    // Checkpoint and restore
+    SimOS savedOS{ 2, 100, 10 };
+    savedOS.NewProcess();
+    savedOS.NewProcess();
+    savedOS.SimFork();
+    savedOS.AccessMemoryAddress(25);
+    savedOS.TimerInterrupt();
+    savedOS.AccessMemoryAddress(47);
+    savedOS.DiskReadRequest(1, "saved.txt");
+    savedOS.DiskReadRequest(1, "queued.txt");
+    savedOS.SaveCheckpoint("checkpoint_test.bin");
+    SimOS loadedOS{ 1, 50, 5 };
+    loadedOS.LoadCheckpoint("checkpoint_test.bin");
+    assert(loadedOS.GetCPU() == savedOS.GetCPU() && loadedOS.GetReadyQueue() == savedOS.GetReadyQueue());
+    assert(loadedOS.GetDisk(1).PID == savedOS.GetDisk(1).PID && loadedOS.GetDisk(1).fileName == "saved.txt");
+    assert(loadedOS.GetDiskQueue(1).size() == 1 && loadedOS.GetDiskQueue(1)[0].fileName == "queued.txt");
+    assert(loadedOS.GetMemory().size() == savedOS.GetMemory().size() && loadedOS.GetMemory()[1].pageNumber == 4);
+    assert(loadedOS.GetSchedulingStats().arrivedProcesses == 3);
+    for (SimOS* os : { &savedOS, &loadedOS })     // Both continue the same way, including which frame is replaced next
+    {
+        os->DiskJobCompleted(1);
+        os->SimExit();
+        for (unsigned long long address = 0; address < 120; address += 10)
+            os->AccessMemoryAddress(address);
+    }
+    assert(loadedOS.GetCPU() == savedOS.GetCPU() && loadedOS.GetReadyQueue() == savedOS.GetReadyQueue());
+    for (unsigned int i = 0; i < savedOS.GetMemory().size(); i++)
+        assert(loadedOS.GetMemory()[i].frameNumber == savedOS.GetMemory()[i].frameNumber && loadedOS.GetMemory()[i].pageNumber == savedOS.GetMemory()[i].pageNumber);
+    assert(loadedOS.GetSchedulingStats().completedProcesses == savedOS.GetSchedulingStats().completedProcesses);
+    std::ofstream("checkpoint_test.bin") << "not a checkpoint";
+    try {
+        loadedOS.LoadCheckpoint("checkpoint_test.bin");
+        assert(false);
+    } catch (const std::runtime_error& e) {
+        assert(loadedOS.GetCPU() == savedOS.GetCPU());    // A failed load leaves the simulation unchanged
+    }
+    std::remove("checkpoint_test.bin");
+    std::cout << "Checkpoint and restore: Passed - A loaded checkpoint continues exactly like the saved simulation." << std::endl;
+
+    // Cloning
+    SimOS branchedOS{ 1, 30, 10 };
+    branchedOS.NewProcesses(3000);      // Spans several process table chunks
+    branchedOS.AccessMemoryAddress(5);
+    branchedOS.DiskReadRequest(0, "warm.txt");
+    SimOS whatIf = branchedOS.Clone();
+    whatIf.SimExit();
+    whatIf.AccessMemoryAddress(15);
+    whatIf.DiskJobCompleted(0);
+    whatIf.SetProcessIDRecycling(true);
+    whatIf.NewProcess();
+    assert(branchedOS.GetCPU() == 2 && branchedOS.GetReadyQueue().size() == 2998 && branchedOS.GetDisk(0).PID == 1);
+    assert(branchedOS.GetMemory().size() == 1 && branchedOS.GetSchedulingStats().completedProcesses == 0);
+    assert(whatIf.GetCPU() == 3 && whatIf.GetDisk(0).PID == NO_PROCESS && whatIf.GetSchedulingStats().completedProcesses == 1);
+    assert(whatIf.GetReadyQueue().size() == 2999 && whatIf.GetMemory().size() == 2);
+    PolicySimOS<FCFSScheduling, FIFOReplacement, LIFODiskScheduling> fcfsWhatIf{ branchedOS };
+    fcfsWhatIf.TimerInterrupt();
+    branchedOS.TimerInterrupt();
+    assert(fcfsWhatIf.GetCPU() == 2 && branchedOS.GetCPU() == 3);
+    std::cout << "Cloning: Passed - Clones and the original run independently." << std::endl;
+
+    // Threads
+    SimOS threadedOS{ 1, 40, 10 };
+    threadedOS.NewProcess();
+    int firstThread = threadedOS.NewThread();
+    int secondThread = threadedOS.NewThread();
+    threadedOS.NewProcess();
+    assert(firstThread == 2 && secondThread == 3 && threadedOS.GetThreads(1) == std::vector<int>({ 2, 3 }));
+    threadedOS.AccessMemoryAddress(5);
+    threadedOS.TimerInterrupt();                    // Thread 2 runs
+    threadedOS.AccessMemoryAddress(7);              // Hits the page its process loaded
+    threadedOS.AccessMemoryAddress(15);
+    assert(threadedOS.GetMemory().size() == 2 && threadedOS.GetMemory()[1].PID == 1);
+    threadedOS.DiskReadRequest(0, "thread.txt");    // Only the thread blocks
+    assert(threadedOS.GetCPU() == 3 && threadedOS.GetReadyQueue() == std::deque<int>({ 4, 1 }));
+    assert(threadedOS.GetProcessMetrics(2).memoryAccesses == 2 && threadedOS.GetProcessMetrics(2).pageFaults == 1);
+    assert(threadedOS.GetProcessMetrics(1).pageFaults == 1);
+    threadedOS.SimExit();                           // A thread exits alone and leaves the memory in place
+    assert(threadedOS.GetCPU() == 4 && threadedOS.GetMemory().size() == 2 && threadedOS.GetThreads(1) == std::vector<int>({ 2 }));
+    threadedOS.TimerInterrupt();
+    threadedOS.SimExit();                           // The process takes its blocked thread with it
+    threadedOS.DiskJobCompleted(0);
+    assert(threadedOS.GetCPU() == 4 && threadedOS.GetReadyQueue().empty() && threadedOS.GetMemory().empty());
+    std::cout << "Threads: Passed - Threads share their process's pages and are scheduled and blocked on their own." << std::endl;
+
+    // Shared memory
+    SimOS sharingOS{ 1, 40, 10 };
+    sharingOS.NewProcesses(3);
+    int segment = sharingOS.CreateSharedMemory(15);  // Rounded up to 2 pages
+    sharingOS.AttachSharedMemory(segment, 100);
+    sharingOS.AccessMemoryAddress(115);
+    sharingOS.TimerInterrupt();
+    sharingOS.AttachSharedMemory(segment, 0);
+    sharingOS.AccessMemoryAddress(12);              // Same frame as process 1's address 112
+    sharingOS.AccessMemoryAddress(35);
+    assert(sharingOS.GetMemory().size() == 2 && sharingOS.GetMemory()[0].PID == NO_PROCESS && sharingOS.GetProcessMetrics(2).pageFaults == 1);
+    sharingOS.DetachSharedMemory(segment);
+    sharingOS.TimerInterrupt();
+    sharingOS.AccessMemoryAddress(15);              // Private to process 3
+    assert(sharingOS.GetMemory().size() == 3);
+    sharingOS.TimerInterrupt();
+    sharingOS.SimExit();                            // The last process attached frees the segment's frame
+    assert(sharingOS.GetMemory().size() == 2 && sharingOS.GetMemory()[0].PID == 2 && sharingOS.GetMemory()[1].PID == 3);
+    try { sharingOS.DetachSharedMemory(segment); assert(false); } catch (std::logic_error&) {}
+    std::cout << "Shared memory: Passed - Attached processes share a segment's frames until the last one detaches." << std::endl;
+
+    // Message queues
+    SimOS pipelineOS{ 1, 40, 10 };
+    pipelineOS.NewProcesses(2);
+    int pipe = pipelineOS.CreateMessageQueue(2);
+    assert(pipelineOS.ReceiveMessage(pipe).sender == NO_PROCESS);  // Empty, so the consumer blocks
+    assert(pipelineOS.GetCPU() == 2 && pipelineOS.GetReadyQueue().empty());
+    assert(pipelineOS.SendMessage(pipe, 42));                        // Wakes the consumer
+    assert(pipelineOS.GetReadyQueue() == std::deque<int>({ 1 }));
+    assert(pipelineOS.SendMessage(pipe, 7) && pipelineOS.SendMessage(pipe, 8) && !pipelineOS.SendMessage(pipe, 9));
+    pipelineOS.TimerInterrupt();
+    Message woken = pipelineOS.ReceiveMessage(pipe);
+    assert(woken.sender == 2 && woken.handle == 42 && pipelineOS.ReceiveMessage(pipe).handle == 7);
+    MessageQueueStats pipeStats = pipelineOS.GetMessageQueueStats(pipe);
+    assert(pipeStats.sent == 3 && pipeStats.received == 2 && pipeStats.rejectedSends == 1 && pipeStats.blockedReceives == 1);
+    assert(pipeStats.depth == 1 && pipeStats.maxDepth == 2 && pipeStats.latency.max == DEFAULT_TIME_QUANTUM);
+    std::cout << "Message queues: Passed - Receivers block on empty queues and wake when a message is sent." << std::endl;
+
+    // Seek-aware disk scheduling
+    DynamicDiskScheduling seekPolicies[] = { DynamicDiskScheduling(FCFSDiskScheduling()), DynamicDiskScheduling(SSTFDiskScheduling()), DynamicDiskScheduling(SCANDiskScheduling()),
+                                             DynamicDiskScheduling(CSCANDiskScheduling()), DynamicDiskScheduling(CLOOKDiskScheduling()) };
+    std::vector<int> servedOrders[] = { { 1, 2, 3, 4, 5 }, { 1, 4, 2, 5, 3 }, { 1, 4, 2, 5, 3 }, { 1, 4, 2, 3, 5 }, { 1, 4, 2, 3, 5 } };
+    unsigned long long seekDistances[] = { 260, 170, 2036, 2066, 180 };    // SCAN and C-SCAN sweep to the last cylinder, 1023
+    for (int policy = 0; policy < 5; policy++)
+    {
+        PolicySimOS<RoundRobinScheduling, LRUReplacement, DynamicDiskScheduling> seekOS{ 1, 30, 10, RoundRobinScheduling(), LRUReplacement(), seekPolicies[policy] };
+        seekOS.NewProcesses(5);
+        for (unsigned long long cylinder : { 50, 90, 10, 60, 20 })
+            seekOS.DiskReadRequest(0, "seek.txt", cylinder);
+        std::vector<int> served;
+        for (int request = 0; request < 5; request++)
+        {
+            served.push_back(seekOS.GetDisk(0).PID);
+            seekOS.DiskJobCompleted(0);
+        }
+        assert(served == servedOrders[policy] && seekOS.GetDiskSeekStats(0).seekDistance == seekDistances[policy]);
+        assert(seekOS.GetDiskSeekStats(0).requestsServed == 5);
+    }
+    std::cout << "Seek-aware disk scheduling: Passed - SSTF, SCAN, C-SCAN and C-LOOK serve requests in head order." << std::endl;
+
+    // Disk service-time model
+    SimOS ioOS{ 2, 30, 10 };
+    ioOS.NewProcesses(3);
+    ioOS.SetDiskServiceModel(0, DiskServiceModel{ 2, 0.5, 4, 6, 0 });    // Hard disk: settle, per cylinder, rotation, transfer
+    ioOS.SetDiskServiceModel(1, DiskServiceModel{ 0, 0, 0, 1, 3 });      // SSD-like: constant latency and transfer
+    ioOS.DiskReadRequest(0, "far.txt", 100);                           // Seeks 100 cylinders: 2 + 50 + 4 + 6
+    ioOS.DiskReadRequest(0, "near.txt", 100);                          // Waits behind it
+    ioOS.TimerInterrupt();
+    ioOS.DiskReadRequest(1, "flash.txt");
+    ioOS.DiskJobCompleted(0);                                          // Starts the second request at time 10, without a seek
+    DiskReport hardDisk = ioOS.GetDiskReport(0);
+    DiskReport flashDisk = ioOS.GetDiskReport(1);
+    assert(hardDisk.requestsStarted == 2 && hardDisk.busyTime == 72 && hardDisk.queueDepth.max == 1);
+    assert(hardDisk.serviceTime.max == 62 && hardDisk.serviceTime.min == 10 && hardDisk.waitTime.max == 10 && hardDisk.responseTime.min == 20);
+    assert(flashDisk.busyTime == 4 && flashDisk.utilization < 1 && hardDisk.utilization > 1);   // The hard disk is saturated
+    std::cout << "Disk service-time model: Passed - Per-disk latency histograms show which disk is saturated." << std::endl;
+
+    // File block cache
+    SimOS cacheOS{ 1, 30, 10 };
+    cacheOS.SetFileCache(true);
+    cacheOS.SetDiskServiceModel(0, DiskServiceModel{ 0, 0, 0, 5, 0 });
+    cacheOS.NewProcesses(2);
+    cacheOS.DiskReadRequest(0, "hot.txt");          // Miss
+    cacheOS.DiskReadRequest(0, "hot.txt");          // Miss, the first read hasn't finished
+    cacheOS.DiskJobCompleted(0);                    // Caches the block
+    cacheOS.DiskReadRequest(0, "hot.txt");          // Hit: process 1 keeps the CPU
+    assert(cacheOS.GetCPU() == 1 && cacheOS.GetMemory().size() == 1 && cacheOS.GetMemory()[0].PID == NO_PROCESS);
+    FileCacheStats cacheStats = cacheOS.GetFileCacheStats();
+    assert(cacheStats.hits == 1 && cacheStats.misses == 2 && cacheStats.requestsSkipped == 1 && cacheStats.timeSaved == 10);
+    cacheOS.AccessMemoryAddress(0);
+    cacheOS.AccessMemoryAddress(10);
+    cacheOS.AccessMemoryAddress(20);                // Process pages push the block out of memory
+    assert(cacheOS.GetFileCacheStats().cachedBlocks == 0);
+    cacheOS.DiskReadRequest(0, "hot.txt");
+    assert(cacheOS.GetCPU() == NO_PROCESS && cacheOS.GetFileCacheStats().misses == 3);
+    std::cout << "File block cache: Passed - Cached reads skip the disk, and blocks compete with pages for frames." << std::endl;
+
+    // Interned file names
+    SimOS internOS{ 1, 30, 10 };
+    internOS.NewProcesses(3);
+    int logID = internOS.InternFileName("a_rather_long_log_file_name_that_would_not_fit_in_a_small_string.log");
+    assert(logID == internOS.InternFileName("a_rather_long_log_file_name_that_would_not_fit_in_a_small_string.log") && logID != internOS.InternFileName("other.txt"));
+    internOS.DiskReadRequest(0, logID, 7);
+    internOS.DiskReadRequest(0, "other.txt");
+    internOS.DiskReadRequest(0, logID, 3);
+    assert(internOS.GetDisk(0).fileName == "a_rather_long_log_file_name_that_would_not_fit_in_a_small_string.log" && internOS.GetDisk(0).cylinder == 7);
+    assert(internOS.GetDiskQueue(0).size() == 2 && internOS.GetDiskQueue(0)[0].fileName == "other.txt" && internOS.GetDiskQueue(0)[1].PID == 3);
+    internOS.DiskJobCompleted(0);
+    internOS.DiskJobCompleted(0);
+    internOS.DiskJobCompleted(0);
+    assert(internOS.GetDisk(0).PID == NO_PROCESS && internOS.GetDisk(0).fileName == "");
+    try { internOS.DiskReadRequest(0, 99, 0); assert(false); } catch (std::out_of_range&) {}
+    std::cout << "Interned file names: Passed - Requests carry file name IDs and report the interned names." << std::endl;
+
+    // Batched disk submission and completion
+    SimOS batchOS{ 2, 30, 10 };
+    SimOS callOS{ 2, 30, 10 };
+    batchOS.NewProcesses(4);
+    callOS.NewProcesses(4);
+    int batchFile = batchOS.InternFileName("batch.txt");
+    int callFile = callOS.InternFileName("batch.txt");
+    assert(batchOS.SubmitDiskReads({ { 0, batchFile, 5 }, { 1, batchFile, 2 }, { 0, batchFile, 9 } }) == 3);   // Issued by processes 1, 2 and 3
+    callOS.DiskReadRequest(0, callFile, 5);
+    callOS.DiskReadRequest(1, callFile, 2);
+    callOS.DiskReadRequest(0, callFile, 9);
+    assert(batchOS.GetCPU() == 4 && batchOS.GetCPU() == callOS.GetCPU() && batchOS.GetReadyQueue() == callOS.GetReadyQueue());
+    assert(batchOS.GetDisk(1).PID == 2 && batchOS.GetDiskQueue(0).size() == 1 && batchOS.GetDiskQueue(0)[0].PID == 3);
+    assert(batchOS.SubmitDiskReads({ { 0, batchFile, 0 }, { 0, batchFile, 0 } }) == 1);   // The CPU is idle after the first read
+    try { batchOS.SubmitDiskReads({ { 0, batchFile, 0 }, { 2, batchFile, 0 } }); assert(false); } catch (std::out_of_range&) {}
+    std::vector<DiskCompletion> completions = batchOS.CompleteDiskJobs({ 1, 0, 1, 0 });   // Disk 1 is idle the second time
+    assert(completions.size() == 3 && completions[0].PID == 2 && completions[1].PID == 1 && completions[2].diskNumber == 0 && completions[2].PID == 3);
+    assert(batchOS.GetCPU() == 2 && batchOS.GetReadyQueue() == std::deque<int>({ 1, 3 }));
+    try { batchOS.CompleteDiskJobs({ 0, -1 }); assert(false); } catch (std::out_of_range&) {}
+    assert(batchOS.GetDisk(0).PID == 4);   // A bad batch completes nothing
+    std::cout << "Batched disk I/O: Passed - A batch of reads or completions does what the calls one at a time would do." << std::endl;
+
+    // Multi-queue disks
+    SimOS nvmeOS{ 1, 30, 10 };
+    try { nvmeOS.SetDiskParallelism(0, 0, 2); assert(false); } catch (std::invalid_argument&) {}
+    nvmeOS.SetDiskParallelism(0, 2, 2);
+    nvmeOS.NewProcesses(5);
+    for (int i = 0; i < 4; i++)
+        nvmeOS.DiskReadRequest(0, "nvme.txt");      // Processes 1 and 2 get the slots, 3 and 4 wait in hardware queues 1 and 0
+    assert(nvmeOS.GetDisk(0, 0).PID == 1 && nvmeOS.GetDisk(0, 1).PID == 2 && nvmeOS.GetDiskQueue(0).size() == 2);
+    try { nvmeOS.SetDiskParallelism(0, 1, 1); assert(false); } catch (std::logic_error&) {}
+    try { nvmeOS.GetDisk(0, 2); assert(false); } catch (std::out_of_range&) {}
+    nvmeOS.DiskJobCompleted(0, 1);                  // Out of order: slot 1 finishes first and takes process 4 from hardware queue 0
+    assert(nvmeOS.GetDisk(0, 1).PID == 4 && nvmeOS.GetDisk(0).PID == 1);
+    nvmeOS.DiskJobCompleted(0);                     // The oldest job, in slot 0, finishes and the slot takes process 3 from hardware queue 1
+    assert(nvmeOS.GetDisk(0, 0).PID == 3 && nvmeOS.GetDiskQueue(0).empty() && nvmeOS.GetReadyQueue() == std::deque<int>({ 2, 1 }));
+    std::vector<DiskCompletion> nvmeCompletions = nvmeOS.CompleteDiskJobs({ 0, 0 });
+    assert(nvmeCompletions.size() == 2 && nvmeCompletions[0].slot == 1 && nvmeCompletions[0].PID == 4 && nvmeCompletions[1].PID == 3);
+    assert(nvmeOS.GetDiskReport(0).requestsStarted == 4 && nvmeOS.GetDisk(0).PID == NO_PROCESS);
+    std::cout << "Multi-queue disks: Passed - Slots serve requests in parallel and complete out of order." << std::endl;
+
+    // RAID volumes
+    SimOS raidOS{ 4, 30, 10 };
+    raidOS.NewProcesses(3);
+    int stripe = raidOS.CreateVolume(RAID0, { 0, 1 });
+    int mirror = raidOS.CreateVolume(RAID1, { 2, 3 });
+    int parity = raidOS.CreateVolume(RAID5, { 0, 1, 2 });
+    try { raidOS.CreateVolume(RAID5, { 0, 1 }); assert(false); } catch (std::invalid_argument&) {}
+    try { raidOS.CreateVolume(RAID0, { 0, 0 }); assert(false); } catch (std::invalid_argument&) {}
+    try { raidOS.VolumeReadRequest(stripe, "big.dat", 2047, 2); assert(false); } catch (std::out_of_range&) {}
+    raidOS.VolumeReadRequest(stripe, "big.dat", 0, 4);     // Two blocks on each disk
+    raidOS.VolumeReadRequest(mirror, "copy.dat", 0, 2);    // One block from each copy
+    assert(raidOS.GetCPU() == 3 && raidOS.GetDisk(0).PID == 1 && raidOS.GetDiskQueue(0).size() == 1 && raidOS.GetDisk(2).PID == 2 && raidOS.GetDisk(3).PID == 2);
+    raidOS.DiskJobCompleted(0);
+    raidOS.DiskJobCompleted(1);
+    raidOS.DiskJobCompleted(0);
+    assert(raidOS.GetReadyQueue().empty());                 // Process 1 waits for its last block
+    raidOS.DiskJobCompleted(1);
+    raidOS.DiskJobCompleted(2);
+    raidOS.DiskJobCompleted(3);
+    assert(raidOS.GetReadyQueue() == std::deque<int>({ 1, 2 }));
+    try { raidOS.FailVolumeDisk(stripe, 0); assert(false); } catch (std::logic_error&) {}
+    raidOS.FailVolumeDisk(parity, 0);
+    try { raidOS.FailVolumeDisk(parity, 1); assert(false); } catch (std::logic_error&) {}
+    raidOS.VolumeReadRequest(parity, "big.dat", 0, 1);     // Block 0 is on the failed disk, so it is rebuilt from disks 1 and 2
+    VolumeStats parityStats = raidOS.GetVolumeStats(parity);
+    assert(parityStats.subrequests == 2 && parityStats.reconstructionReads == 1 && parityStats.pendingReads == 1 && parityStats.capacity == 2 * DEFAULT_DISK_CYLINDERS);
+    assert(raidOS.CompleteDiskJobs({ 1, 2 }).size() == 2 && raidOS.GetReadyQueue().back() == 3);
+    assert(raidOS.GetVolumeStats(stripe).subrequests == 4 && raidOS.GetVolumeStats(stripe).responseTime.count == 1);
+    std::cout << "RAID volumes: Passed - Reads are split across the disks and wake the process when the last block arrives." << std::endl;
+
+    // Replica placement
+    SimOS replicaOS{ 3, 30, 10 };
+    replicaOS.NewProcesses(4);
+    int balanced = replicaOS.CreateReplicaSet(SHORTEST_QUEUE, { 0, 1, 2 });
+    int fixed = replicaOS.CreateReplicaSet(STATIC_PLACEMENT, { 0, 1, 2 });
+    try { replicaOS.CreateReplicaSet(3, { 0 }); assert(false); } catch (std::invalid_argument&) {}
+    assert(replicaOS.ReplicaReadRequest(balanced, "replica.txt", 0) == 0);
+    assert(replicaOS.ReplicaReadRequest(balanced, "replica.txt", 0) == 1);
+    assert(replicaOS.ReplicaReadRequest(balanced, "replica.txt", 0) == 2);
+    assert(replicaOS.ReplicaReadRequest(balanced, "replica.txt", 0) == 0);   // Every disk has a request, so the first one gets it
+    ReplicaSetStats balancedStats = replicaOS.GetReplicaSetStats(balanced);
+    assert(balancedStats.reads == 4 && balancedStats.busiestDiskReads == 2 && balancedStats.quietestDiskReads == 1 && balancedStats.queueImbalance.max == 1);
+    replicaOS.DiskJobCompleted(0);
+    assert(replicaOS.ReplicaReadRequest(fixed, "replica.txt", 0) == 1);      // Process 1 always reads from disk 1, however busy it is
+    try { replicaOS.ReplicaReadRequest(fixed, "replica.txt", 0); assert(false); } catch (std::logic_error&) {}
+    SimOS completionOS{ 2, 30, 10 };
+    completionOS.SetDiskServiceModel(0, DiskServiceModel{ 0, 0, 0, 0, 10 });
+    completionOS.SetDiskServiceModel(1, DiskServiceModel{ 0, 0, 0, 0, 1 });
+    completionOS.NewProcesses(3);
+    int earliest = completionOS.CreateReplicaSet(EARLIEST_COMPLETION, { 0, 1 });
+    for (int i = 0; i < 3; i++)
+        assert(completionOS.ReplicaReadRequest(earliest, "replica.txt", 0) == 1);   // The fast disk finishes three reads before the slow one finishes one
+    std::cout << "Replica placement: Passed - Reads go to the least loaded copy, and the imbalance is tracked." << std::endl;
+
+    // Disk request cancellation
+    SimOS cancelOS{ 1, 30, 10 };
+    cancelOS.SetDiskServiceModel(0, DiskServiceModel{ 0, 0, 0, 5, 0 });
+    cancelOS.NewProcess();
+    cancelOS.SimFork();
+    cancelOS.SimFork();
+    cancelOS.SimFork();
+    cancelOS.TimerInterrupt();
+    cancelOS.DiskReadRequest(0, "child.txt");       // Process 2 is served, 3 and 4 wait
+    cancelOS.DiskReadRequest(0, "child.txt");
+    cancelOS.DiskReadRequest(0, "child.txt");
+    assert(cancelOS.GetCPU() == 1 && cancelOS.GetDiskQueue(0).size() == 2);
+    cancelOS.SimExit();                             // Cascading termination cancels the children's waiting requests
+    DiskReport cancelReport = cancelOS.GetDiskReport(0);
+    assert(cancelOS.GetDiskQueue(0).empty() && cancelOS.GetDisk(0).PID == 2 && cancelReport.requestsCancelled == 2 && cancelReport.timeReclaimed == 10);
+    cancelOS.DiskJobCompleted(0);
+    assert(cancelOS.GetDisk(0).PID == NO_PROCESS && cancelOS.GetReadyQueue().empty() && cancelOS.GetDiskReport(0).requestsStarted == 1);
+    SimOS threadExitOS{ 1, 30, 10 };
+    threadExitOS.NewProcess();
+    threadExitOS.NewProcess();
+    threadExitOS.DiskReadRequest(0, "held.txt");    // Process 1 holds the disk
+    int exitingThread = threadExitOS.NewThread();
+    threadExitOS.SimFork();
+    threadExitOS.TimerInterrupt();
+    assert(threadExitOS.GetCPU() == exitingThread);
+    threadExitOS.DiskReadRequest(0, "thread.txt");
+    threadExitOS.TimerInterrupt();
+    assert(threadExitOS.GetCPU() == 2 && threadExitOS.GetDiskQueue(0).size() == 1);
+    threadExitOS.SimExit();                         // A parent's own threads are cancelled along with its descendants
+    assert(threadExitOS.GetDiskQueue(0).empty() && threadExitOS.GetDiskReport(0).requestsCancelled == 1);
+    threadExitOS.DiskJobCompleted(0);
+    assert(threadExitOS.GetDisk(0).PID == NO_PROCESS);
+    std::cout << "Disk request cancellation: Passed - Terminated processes' waiting requests are dropped and the disk time is reported." << std::endl;
+
+    // File system extents
+    SimOS fileOS{ 1, 30, 10 };
+    fileOS.SetDiskServiceModel(0, DiskServiceModel{ 0, 0, 5, 1, 0 });
+    fileOS.CreateFile(0, "a.dat", 10);
+    fileOS.CreateFile(0, "b.dat", 10);
+    fileOS.CreateFile(0, "c.dat", DEFAULT_DISK_BLOCKS - 25);    // Leaves 5 free blocks at the end of the disk
+    fileOS.DeleteFile(0, "b.dat");
+    fileOS.CreateFile(0, "d.dat", 15);                          // No free extent fits it, so it takes the hole of b.dat and the end of the disk
+    std::vector<Extent> fragmented = fileOS.GetFileExtents(0, "d.dat");
+    assert(fragmented.size() == 2 && fragmented[0].firstBlock == 10 && fragmented[0].blockCount == 10 && fragmented[1].firstBlock == DEFAULT_DISK_BLOCKS - 5);
+    try { fileOS.CreateFile(0, "e.dat", 1); assert(false); } catch (std::runtime_error&) {}
+    try { fileOS.CreateFile(0, "a.dat", 1); assert(false); } catch (std::logic_error&) {}
+    try { fileOS.ReadFile(0, "d.dat"); assert(false); } catch (std::logic_error&) {}
+    fileOS.NewProcess();
+    try { fileOS.ReadFile(0, "d.dat", 10, 6); assert(false); } catch (std::out_of_range&) {}
+    try { fileOS.ReadFile(0, "b.dat"); assert(false); } catch (std::out_of_range&) {}
+    fileOS.ReadFile(0, "d.dat");                                // One request per extent
+    assert(fileOS.GetDisk(0).PID == 1 && fileOS.GetDisk(0).blockCount == 10 && fileOS.GetDiskQueue(0).size() == 1 && fileOS.GetDiskQueue(0)[0].blockCount == 5);
+    fileOS.DiskJobCompleted(0);
+    assert(fileOS.GetCPU() == NO_PROCESS);                      // Process 1 waits for its second extent
+    fileOS.DiskJobCompleted(0);
+    assert(fileOS.GetCPU() == 1 && fileOS.GetDiskReport(0).busyTime == 15 + 10);
+    fileOS.DeleteFile(0, "a.dat");
+    FileSystemStats fileStats = fileOS.GetFileSystemStats(0);
+    assert(fileStats.files == 2 && fileStats.fileExtents == 3 && fileStats.freeBlocks == 10 && fileStats.freeExtents == 1 && fileStats.externalFragmentation == 0);
+    assert(fileStats.reads == 1 && fileStats.blocksRead == 15 && fileStats.extentRequests == 2);
+    std::cout << "File system extents: Passed - Files fragment as the disk ages, and reads cost one request per extent." << std::endl;
+
    std::cout << "Good job, you passed!" << std::endl;
     return 0;
 
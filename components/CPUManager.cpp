@@ -6,10 +6,21 @@
 /*
     @post   Ready queue is initialized with 0 elements.
             Current Process is set to some dummy process ID with PID 0.
+            The simulated clock starts at 0 and the time quantum is set to DEFAULT_TIME_QUANTUM.
+            Context switches cost nothing until a cost model is set.
 */
 CPUManager::CPUManager(): 
     readyQueue_{},
-    currentProcess_{0}
+    currentProcess_{0},
+    currentTime_{0},
+    timeQuantum_{DEFAULT_TIME_QUANTUM},
+    stats_{},
+    switchCost_{},
+    switchReport_{},
+    lastRunProcess_{NO_PROCESS},
+    lastRunTime_{},
+    realTime_{},
+    releasedProcesses_{}
 {
 }
 
@@ -19,7 +30,16 @@ CPUManager::CPUManager():
 */
 CPUManager::CPUManager(const CPUManager& rhs):
     readyQueue_{std::move(rhs.readyQueue_)}, 
-    currentProcess_{rhs.currentProcess_}
+    currentProcess_{rhs.currentProcess_},
+    currentTime_{rhs.currentTime_},
+    timeQuantum_{rhs.timeQuantum_},
+    stats_{rhs.stats_},
+    switchCost_{rhs.switchCost_},
+    switchReport_{rhs.switchReport_},
+    lastRunProcess_{rhs.lastRunProcess_},
+    lastRunTime_{rhs.lastRunTime_},
+    realTime_{rhs.realTime_},
+    releasedProcesses_{rhs.releasedProcesses_}
 {
 }   
 
@@ -32,6 +52,15 @@ CPUManager& CPUManager::operator=(const CPUManager& rhs)
 {
     readyQueue_ = std::move(rhs.readyQueue_);
     currentProcess_ = rhs.currentProcess_;
+    currentTime_ = rhs.currentTime_;
+    timeQuantum_ = rhs.timeQuantum_;
+    stats_ = rhs.stats_;
+    switchCost_ = rhs.switchCost_;
+    switchReport_ = rhs.switchReport_;
+    lastRunProcess_ = rhs.lastRunProcess_;
+    lastRunTime_ = rhs.lastRunTime_;
+    realTime_ = rhs.realTime_;
+    releasedProcesses_ = rhs.releasedProcesses_;
 
     return *this;
 }  
@@ -42,7 +71,16 @@ CPUManager& CPUManager::operator=(const CPUManager& rhs)
 */
 CPUManager::CPUManager(CPUManager&& rhs):
     readyQueue_{std::move(rhs.readyQueue_)}, 
-    currentProcess_{rhs.currentProcess_}
+    currentProcess_{rhs.currentProcess_},
+    currentTime_{rhs.currentTime_},
+    timeQuantum_{rhs.timeQuantum_},
+    stats_{std::move(rhs.stats_)},
+    switchCost_{rhs.switchCost_},
+    switchReport_{rhs.switchReport_},
+    lastRunProcess_{rhs.lastRunProcess_},
+    lastRunTime_{std::move(rhs.lastRunTime_)},
+    realTime_{std::move(rhs.realTime_)},
+    releasedProcesses_{std::move(rhs.releasedProcesses_)}
 {
 }          
 
@@ -55,6 +93,15 @@ CPUManager& CPUManager::operator=(CPUManager&& rhs)
 {
     readyQueue_ = std::move(rhs.readyQueue_);
     currentProcess_ = rhs.currentProcess_;
+    currentTime_ = rhs.currentTime_;
+    timeQuantum_ = rhs.timeQuantum_;
+    stats_ = std::move(rhs.stats_);
+    switchCost_ = rhs.switchCost_;
+    switchReport_ = rhs.switchReport_;
+    lastRunProcess_ = rhs.lastRunProcess_;
+    lastRunTime_ = std::move(rhs.lastRunTime_);
+    realTime_ = std::move(rhs.realTime_);
+    releasedProcesses_ = std::move(rhs.releasedProcesses_);
 
     return *this;
 }       
@@ -69,6 +116,24 @@ void CPUManager::setReadyQueue(const std::deque<int>& readyQueue)
     readyQueue_ = readyQueue;
 }
 
+/*
+    @param  The length of a time slice in simulated time units.
+    @post   Every following timer interrupt advances the simulated clock by the new time quantum.
+*/
+void CPUManager::setTimeQuantum(const unsigned long long& timeQuantum)
+{
+    timeQuantum_ = timeQuantum;
+}
+
+/*
+    @param  A const lvalue reference to the cost model.
+    @post   Every following context switch advances the simulated clock by the switch overhead plus the warm-up penalty of the incoming process.
+*/
+void CPUManager::setContextSwitchCost(const ContextSwitchCost& cost)
+{
+    switchCost_ = cost;
+}
+
 //--------------------------------------------Getters--------------------------------------------
 
 /*
@@ -84,47 +149,215 @@ int CPUManager::getCurrentProcessID() const
 }
 
 /*
-    @return The ready queue.
+    @return The ready queue of the round-robin class.
+            Real-time processes waiting for the CPU are listed by getRealTimeQueue().
 */
 std::deque<int> CPUManager::getReadyQueue() const
 {
     return readyQueue_;
 }
 
+/*
+    @return The current simulated time.
+*/
+unsigned long long CPUManager::getCurrentTime() const
+{
+    return currentTime_;
+}
+
+/*
+    @return The length of a time slice in simulated time units.
+*/
+unsigned long long CPUManager::getTimeQuantum() const
+{
+    return timeQuantum_;
+}
+
+/*
+    @return The scheduling metrics of every process the CPU manager has seen.
+*/
+const SchedulingStats& CPUManager::getStats() const
+{
+    return stats_;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @return The scheduling metrics of the process as of the current simulated time.
+*/
+ProcessMetrics CPUManager::getProcessMetrics(const int& processID) const
+{
+    return stats_.getProcessMetrics(processID, currentTime_);
+}
+
+/*
+    @return The context switch cost model.
+*/
+ContextSwitchCost CPUManager::getContextSwitchCost() const
+{
+    return switchCost_;
+}
+
+/*
+    @return The number of context switches, the time they cost and the resulting CPU efficiency.
+*/
+ContextSwitchReport CPUManager::getContextSwitchReport() const
+{
+    ContextSwitchReport report = switchReport_;
+    unsigned long long lostTime = report.switchOverheadTime + report.warmupTime;
+    if (report.usefulTime + lostTime > 0)
+        report.efficiency = static_cast<double>(report.usefulTime) / (report.usefulTime + lostTime);
+    return report;
+}
+
+/*
+    @return True if a real-time job or a process in the ready queue is waiting for the CPU.
+*/
+bool CPUManager::hasReadyProcess() const
+{
+    return !readyQueue_.empty() || realTime_.hasReadyJob();
+}
+
+/*
+    @return True if any process belongs to the real-time scheduling class.
+*/
+bool CPUManager::hasRealTimeProcesses() const
+{
+    return !realTime_.isEmpty();
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @return True if the process belongs to the real-time scheduling class.
+*/
+bool CPUManager::isRealTimeProcess(const int& processID) const
+{
+    return realTime_.isRealTime(processID);
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @return True if the process is a real-time process that finished its current job and sleeps until its next release.
+*/
+bool CPUManager::isWaitingForRelease(const int& processID) const
+{
+    return realTime_.isSleeping(processID);
+}
+
+/*
+    @return The PIDs of the real-time processes waiting for the CPU, earliest deadline first.
+*/
+std::vector<int> CPUManager::getRealTimeQueue() const
+{
+    return realTime_.getReadyQueue();
+}
+
+/*
+    @return The PIDs of the real-time processes whose next job was released by the last timer interrupt.
+*/
+std::vector<int> CPUManager::getReleasedProcesses() const
+{
+    return releasedProcesses_;
+}
+
+/*
+    @return Admission counters, deadline misses and the lateness distribution of the real-time class.
+*/
+RealTimeReport CPUManager::getRealTimeReport() const
+{
+    return realTime_.getReport();
+}
+
 //--------------------------------------------Utilities--------------------------------------------
 
 /*
     @param  A reference to a process ID.
     @post   If there is no currently running process, the process begins running instantly with state 'Running'.
             Otherwise, the process is added to the ready queue with state 'Ready'.
-    @return READY if the process was sent to the readyqueue, RUNNING if the process immediately began using the CPU
+            Real-time processes wait in the EDF heap instead of the ready queue, and don't wait at all while sleeping until their next release.
+    @return READY if the process was sent to the readyqueue, RUNNING if the process immediately began using the CPU,
+            WAITING if the process is a real-time process sleeping until its next release
 */
 int CPUManager::addProcess(const int &process)
 {
-    if (currentProcess_ != 0)
+    if (realTime_.isRealTime(process))
+    {
+        if (currentProcess_ == 0 && !realTime_.isSleeping(process))
+        {
+            dispatch(process);
+            return RUNNING;
+        }
+        return realTime_.makeRunnable(process) ? READY : WAITING;
+    }
+    else if (currentProcess_ != 0)
     {
         readyQueue_.push_back(process);
         return READY;
     }
     else
     {
-        currentProcess_ = process;
+        dispatch(process);
         return RUNNING;
     }
 }
 
 /*
-    @post   If the ready queue is not empty, the CPU begins running the first process in the ready queue.
+    @param  A const lvalue reference to the first of a run of consecutive process IDs, none of them real-time.
+    @param  The number of processes in the run.
+    @post   Same as adding each process with addProcess(), with the ready queue growing once for the whole run.
+    @return RUNNING if the first process immediately began using the CPU, READY if it was sent to the ready queue like the others.
+*/
+int CPUManager::addProcesses(const int& firstProcess, const unsigned int& count)
+{
+    if (count == 0)
+        return READY;
+
+    int firstState{READY};
+    int nextProcess = firstProcess;
+    if (currentProcess_ == NO_PROCESS)
+    {
+        dispatch(nextProcess++);
+        firstState = RUNNING;
+    }
+
+    std::deque<int>::size_type queued = readyQueue_.size();
+    readyQueue_.resize(queued + (firstProcess + count - nextProcess));
+    for (std::deque<int>::iterator i = readyQueue_.begin() + queued; i != readyQueue_.end(); i++)
+        *i = nextProcess++;
+    return firstState;
+}
+
+/*
+    @param  A const lvalue reference to the ID of a new process.
+    @param  A const lvalue reference to the period, relative deadline and budget of the process.
+    @post   If the process passes the EDF utilization test, it joins the real-time class with its first job released now.
+            The process still has to be handed to addProcess() to be scheduled.
+    @return True if the process was admitted, false otherwise.
+*/
+bool CPUManager::admitRealTimeProcess(const int& process, const RealTimeParameters& parameters)
+{
+    return realTime_.admit(process, parameters, currentTime_);
+}
+
+/*
+    @post   If a real-time job is waiting, the CPU begins running the one with the earliest deadline.
+            Otherwise, if the ready queue is not empty, the CPU begins running the first process in the ready queue.
             Note: This function immediately overwrites the data of the currently running process, so to avoid losing it, save it before calling this function.
     @return An std::pair object with the first element being the PID of the new current process, and the second element being the current process's new state.
             std::pair<0, 0> if there are no other processes in the ready queue.
 */
 std::pair<int, int> CPUManager::runFirstProcess()
 {
-    if (!readyQueue_.empty())
+    if (realTime_.hasReadyJob())
     {
-        currentProcess_ = readyQueue_.front();
+        dispatch(realTime_.popEarliest());
+        return std::make_pair(currentProcess_, RUNNING);
+    }
+    else if (!readyQueue_.empty())
+    {
+        int nextProcess = readyQueue_.front();
         readyQueue_.pop_front();
+        dispatch(nextProcess);
         return std::make_pair(currentProcess_, RUNNING);    //Return the currentProcess PID and its current state
     }
     else
@@ -147,19 +380,351 @@ void CPUManager::killRunningProcess()
     @post   The currently running process is moved to the back of the ready queue with state 'Ready'.
             The first process in the ready queue begins executing with state 'Running'.
             If the ready queue is empty, the process that was just paused by the timer interrupt resumes running as there are no processes waiting to be executed.
+            The simulated clock advances by one time quantum, which is credited to the interrupted process.
+            Real-time jobs whose release time passed are woken up, and a waiting real-time job preempts a round-robin process or a real-time job with a later deadline.
+            A real-time process keeps the CPU over round-robin processes until its job's budget runs out, and then sleeps until its next release.
+            Same as timerInterrupt(RoundRobinScheduling()).
     @return An std::pair object with the first element being the PID of the current Process and the second element being the state of the current process.
 */
 std::pair<int, int> CPUManager::timerInterrupt()
+{
+    return timerInterrupt(RoundRobinScheduling());
+}
+
+/*
+    @param  The number of timer interrupts to apply.
+    @post   Same as calling timerInterrupt() count times.
+            Same as timerInterrupt(RoundRobinScheduling(), count).
+    @return An std::pair object with the first element being the PID of the current Process and the second element being the state of the current process.
+*/
+std::pair<int, int> CPUManager::timerInterrupt(const unsigned long long& count)
+{
+    return timerInterrupt(RoundRobinScheduling(), count);
+}
+
+/*
+    @param  A reference to the pair that receives the PID and state of the new current process.
+    @post   The simulated clock advances by one time quantum, which is credited to the interrupted process.
+            Real-time jobs whose release time passed are woken up, and the time their processes slept is recorded as blocked time.
+            A real-time process whose job is done gives up the CPU, and a waiting real-time job preempts a round-robin process or a real-time job with a later deadline.
+    @return True if the real-time class decided who runs next, false if the decision is left to the ready queue's scheduling policy.
+*/
+bool CPUManager::endTimeSlice(std::pair<int, int>& newCurrentProcess)
+{
+    int interruptedProcess = currentProcess_;
+    stats_.recordQuanta(interruptedProcess, 1, timeQuantum_);
+    currentTime_ += timeQuantum_;
+    switchReport_.usefulTime += timeQuantum_;
+
+    bool interruptedIsRealTime = realTime_.isRealTime(interruptedProcess);
+    if (interruptedIsRealTime)
+        realTime_.consumeBudget(interruptedProcess, timeQuantum_, currentTime_);
+    releasedProcesses_ = realTime_.releaseDueJobs(currentTime_);
+    for (const int& processID : releasedProcesses_)
+        stats_.recordUnblocked(processID, currentTime_);
+
+    if (interruptedIsRealTime && realTime_.isSleeping(interruptedProcess))
+    {
+        stats_.recordBlocked(interruptedProcess, currentTime_, false);  //Sleeping until the next release isn't waiting in the ready queue
+        killRunningProcess();   //The job is done, so the process gives up the CPU until its next release
+        newCurrentProcess = runFirstProcess();
+        return true;
+    }
+
+    if (realTime_.hasReadyJob() && (!interruptedIsRealTime || realTime_.getEarliestDeadline() < realTime_.getDeadline(interruptedProcess)))
+    {
+        addProcess(interruptedProcess);
+        killRunningProcess();
+        newCurrentProcess = runFirstProcess();
+        return true;
+    }
+
+    if (interruptedIsRealTime)
+    {
+        newCurrentProcess = std::make_pair(currentProcess_, RUNNING);   //Round-robin processes may not preempt a real-time job, so it keeps the CPU without a switch
+        return true;
+    }
+    return false;
+}
+
+/*
+    @post   The currently running process is moved to the back of the ready queue and the first process in the ready queue begins running.
+    @return An std::pair object with the first element being the PID of the current Process and the second element being the state of the current process.
+*/
+std::pair<int, int> CPUManager::rotateReadyQueue()
 {
     addProcess(currentProcess_);
     killRunningProcess();
     return runFirstProcess();
 }
 
+/*
+    @param  The number of timer interrupts to apply.
+    @post   Same as calling timerInterrupt() count times, for a running process on a CPU with no real-time processes.
+            The first rotation of the ready queue (and every rotation while switch costs still depend on how long each process was away) is applied one interrupt at a time.
+            After that every process in the rotation ran within the last rotation, so each further switch costs the same and the rest is computed arithmetically:
+            quanta, context switches and last run times are credited per process, and the ready queue is rotated once.
+            This makes long idle rotations O(ready-queue size) instead of O(count * ready-queue size).
+    @return An std::pair object with the first element being the PID of the current Process and the second element being the state of the current process.
+*/
+std::pair<int, int> CPUManager::rotateReadyQueue(const unsigned long long& count)
+{
+    std::pair<int, int> newCurrentProcess = std::make_pair(currentProcess_, RUNNING);
+    if (readyQueue_.empty())
+    {
+        extendTimeSlice(count);
+        return newCurrentProcess;
+    }
+
+    unsigned long long cycleLength = readyQueue_.size() + 1;
+    unsigned long long applied{0};
+    while (applied < count && (applied < cycleLength || !hasSteadySwitchCost(cycleLength)))
+    {
+        newCurrentProcess = timerInterrupt();
+        applied++;
+    }
+    if (applied == count)
+        return newCurrentProcess;
+
+    //Position 0 is the running process, positions 1 to cycleLength - 1 follow the ready queue.
+    //Interrupt j (counting from 1) ends the quantum of position (j - 1) % cycleLength and switches to position j % cycleLength.
+    std::vector<int> rotation;
+    rotation.reserve(cycleLength);
+    rotation.push_back(currentProcess_);
+    rotation.insert(rotation.end(), readyQueue_.begin(), readyQueue_.end());
+
+    unsigned long long remaining = count - applied;
+    unsigned long long switchCost = switchCost_.switchOverhead + switchCost_.warmupPenalty;
+    unsigned long long startTime = currentTime_;
+    for (unsigned long long position = 0; position < cycleLength; position++)
+    {
+        unsigned long long quanta = remaining / cycleLength + (position < remaining % cycleLength ? 1 : 0);
+        stats_.recordQuanta(rotation[position], quanta, quanta * timeQuantum_);
+
+        unsigned long long firstSwitchIn = position == 0 ? cycleLength : position;
+        if (firstSwitchIn <= remaining)
+            stats_.recordDispatches(rotation[position], (remaining - firstSwitchIn) / cycleLength + 1);
+
+        if (position < remaining)
+        {
+            unsigned long long lastInterrupt = position + 1 + (remaining - position - 1) / cycleLength * cycleLength;
+            lastRunTime_[rotation[position]] = startTime + lastInterrupt * timeQuantum_ + (lastInterrupt - 1) * switchCost;
+        }
+    }
+
+    currentTime_ += remaining * (timeQuantum_ + switchCost);
+    switchReport_.switches += remaining;
+    switchReport_.switchOverheadTime += remaining * switchCost_.switchOverhead;
+    switchReport_.warmupTime += remaining * (switchCost - switchCost_.switchOverhead);
+    switchReport_.usefulTime += remaining * timeQuantum_;
+
+    std::rotate(rotation.begin(), rotation.begin() + remaining % cycleLength, rotation.end());
+    currentProcess_ = rotation.front();
+    lastRunProcess_ = currentProcess_;
+    readyQueue_.assign(rotation.begin() + 1, rotation.end());
+    return std::make_pair(currentProcess_, RUNNING);
+}
+
+/*
+    @param  The number of time slices.
+    @post   The running process keeps the CPU for count more time slices, which are credited to it without a context switch.
+*/
+void CPUManager::extendTimeSlice(const unsigned long long& count)
+{
+    stats_.recordQuanta(currentProcess_, count, count * timeQuantum_);
+    currentTime_ += count * timeQuantum_;
+    switchReport_.usefulTime += count * timeQuantum_;
+}
+
 /*
     @return A flag that indicates whether or not the CPU is currently running a process.
 */
 bool CPUManager::isBusy() const
 {
     return currentProcess_ != NO_PROCESS;
-}
\ No newline at end of file
+}
+
+/*
+    @param  A const lvalue reference to the process ID to run.
+    @post   The process becomes the currently running process and the cost of switching to it is charged to the simulated clock.
+*/
+void CPUManager::dispatch(const int& process)
+{
+    currentProcess_ = process;
+    stats_.recordDispatch(process, currentTime_);
+    currentTime_ += chargeContextSwitch(process);
+}
+
+/*
+    @param  The number of processes taking turns on the CPU.
+    @return True if, once every process in the rotation has run, each switch costs the same no matter how long ago it ran:
+            either the warm-up penalty is constant (0, or no warmth window), or a full rotation already outlasts the warmth window.
+*/
+bool CPUManager::hasSteadySwitchCost(const unsigned long long& cycleLength) const
+{
+    return switchCost_.warmupPenalty == 0 || switchCost_.warmthWindow == 0 || (cycleLength - 1) * timeQuantum_ >= switchCost_.warmthWindow;
+}
+
+/*
+    @param  A const lvalue reference to the process ID being loaded onto the CPU.
+    @post   The process that last ran is stamped with the time it left the CPU.
+            The switch overhead and warm-up penalty are added to the context switch report.
+    @return The time the switch takes.
+            Nothing is charged if the process is the one whose state is still loaded on the CPU.
+            The warm-up penalty grows linearly with the time the process was away, up to the full penalty after the warmth window.
+*/
+unsigned long long CPUManager::chargeContextSwitch(const int& process)
+{
+    if (process == lastRunProcess_)
+        return 0;
+
+    if (lastRunProcess_ != NO_PROCESS)
+        lastRunTime_[lastRunProcess_] = currentTime_;
+    lastRunProcess_ = process;
+
+    unsigned long long warmup = switchCost_.warmupPenalty;
+    std::unordered_map<int, unsigned long long>::const_iterator lastRun = lastRunTime_.find(process);
+    if (lastRun != lastRunTime_.end() && switchCost_.warmthWindow > 0)
+    {
+        unsigned long long timeAway = currentTime_ - lastRun->second;
+        if (timeAway < switchCost_.warmthWindow)
+            warmup = switchCost_.warmupPenalty * timeAway / switchCost_.warmthWindow;
+    }
+
+    switchReport_.switches++;
+    switchReport_.switchOverheadTime += switchCost_.switchOverhead;
+    switchReport_.warmupTime += warmup;
+    return switchCost_.switchOverhead + warmup;
+}
+
+//--------------------------------------------Scheduling Metrics--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the ID of a newly created process.
+    @post   The current simulated time is recorded as the arrival time of the process.
+*/
+void CPUManager::recordArrival(const int& processID)
+{
+    stats_.recordArrival(processID, currentTime_);
+}
+
+/*
+    @param  A const lvalue reference to the first of a run of consecutive IDs of newly created processes.
+    @param  The number of processes in the run.
+    @post   The current simulated time is recorded as the arrival time of every process in the run.
+*/
+void CPUManager::recordArrivals(const int& firstProcessID, const unsigned int& count)
+{
+    stats_.recordArrivals(firstProcessID, count, currentTime_);
+}
+
+/*
+    @param  A const lvalue reference to the ID of a process that stopped using the CPU to wait.
+    @param  True if the process waits for a disk, false if it waits for a child.
+    @post   The process is counted as blocked from the current simulated time.
+*/
+void CPUManager::recordBlocked(const int& processID, const bool& onDiskIO)
+{
+    stats_.recordBlocked(processID, currentTime_, onDiskIO);
+}
+
+/*
+    @param  A const lvalue reference to the ID of a process that stopped waiting.
+    @post   The time the process spent blocked is added to its metrics.
+*/
+void CPUManager::recordUnblocked(const int& processID)
+{
+    stats_.recordUnblocked(processID, currentTime_);
+}
+
+/*
+    @param  A const lvalue reference to the ID of the process that accessed memory.
+    @param  A const lvalue reference to whether the access had to load its page.
+    @post   The access is added to the metrics of the process.
+*/
+void CPUManager::recordMemoryAccess(const int& processID, const bool& pageFault)
+{
+    stats_.recordMemoryAccess(processID, pageFault);
+}
+
+/*
+    @param  A const lvalue reference to the ID of a process that exited or was terminated.
+    @post   The process is counted as completed at the current simulated time.
+            A real-time process leaves the real-time class and frees its reserved utilization.
+*/
+void CPUManager::recordCompletion(const int& processID)
+{
+    stats_.recordCompletion(processID, currentTime_);
+    realTime_.removeProcess(processID);
+    lastRunTime_.erase(processID);
+    if (lastRunProcess_ == processID)
+        lastRunProcess_ = NO_PROCESS;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The ready-queue, the running process, the clock, the scheduling statistics, the context switch accounting
+            and the real-time scheduler are appended to the checkpoint.
+*/
+void CPUManager::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.writeArray(std::vector<int>(readyQueue_.begin(), readyQueue_.end()));
+    writer.write(currentProcess_);
+    writer.write(currentTime_);
+    writer.write(timeQuantum_);
+    stats_.writeCheckpoint(writer);
+
+    writer.write(switchCost_);
+    writer.write(switchReport_);
+    writer.write(lastRunProcess_);
+    std::vector<int> lastRunProcesses;
+    std::vector<unsigned long long> lastRunTimes;
+    lastRunProcesses.reserve(lastRunTime_.size());
+    lastRunTimes.reserve(lastRunTime_.size());
+    for (const std::pair<const int, unsigned long long>& lastRun : lastRunTime_)
+    {
+        lastRunProcesses.push_back(lastRun.first);
+        lastRunTimes.push_back(lastRun.second);
+    }
+    writer.writeArray(lastRunProcesses);
+    writer.writeArray(lastRunTimes);
+
+    realTime_.writeCheckpoint(writer);
+    writer.writeArray(releasedProcesses_);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The CPU is in the state it was in when the checkpoint was written.
+
+    @note   If the last run times are corrupt, throw std::runtime_error exception.
+*/
+void CPUManager::readCheckpoint(CheckpointReader& reader)
+{
+    std::vector<int> readyQueue;
+    reader.readArray(readyQueue);
+    readyQueue_.assign(readyQueue.begin(), readyQueue.end());
+    currentProcess_ = reader.read<int>();
+    currentTime_ = reader.read<unsigned long long>();
+    timeQuantum_ = reader.read<unsigned long long>();
+    stats_.readCheckpoint(reader);
+
+    switchCost_ = reader.read<ContextSwitchCost>();
+    switchReport_ = reader.read<ContextSwitchReport>();
+    lastRunProcess_ = reader.read<int>();
+    std::vector<int> lastRunProcesses;
+    std::vector<unsigned long long> lastRunTimes;
+    reader.readArray(lastRunProcesses);
+    reader.readArray(lastRunTimes);
+    if (lastRunProcesses.size() != lastRunTimes.size())
+        throw std::runtime_error("The checkpoint has corrupt context switch accounting");
+    lastRunTime_.clear();
+    lastRunTime_.reserve(lastRunProcesses.size());
+    for (unsigned int i = 0; i < lastRunProcesses.size(); i++)
+        lastRunTime_.emplace(lastRunProcesses[i], lastRunTimes[i]);
+
+    realTime_.readCheckpoint(reader);
+    reader.readArray(releasedProcesses_);
+}
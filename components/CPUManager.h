@@ -4,7 +4,41 @@
 #include <deque>
 #include <list>
 #include <iostream>
+#include <unordered_map>
+#include <algorithm>
 #include "Process.h"
+#include "SchedulingStats.h"
+#include "EDFScheduler.h"
+#include "Checkpoint.h"
+
+constexpr unsigned long long DEFAULT_TIME_QUANTUM{10};   //Length of a time slice in simulated time units
+
+struct ContextSwitchCost
+{
+    unsigned long long switchOverhead{0};   //Fixed time to save and restore process state on every switch
+    unsigned long long warmupPenalty{0};    //Time to refill caches and the TLB for a process whose state is fully cold
+    unsigned long long warmthWindow{0};     //Time away from the CPU after which a process's cache state is fully cold (0 means cold after any switch)
+};
+
+struct ContextSwitchReport
+{
+    unsigned long long switches{0};             //Switches that loaded a different process than the one that last ran
+    unsigned long long switchOverheadTime{0};   //Time spent on the fixed switch overhead
+    unsigned long long warmupTime{0};           //Time spent warming caches back up
+    unsigned long long usefulTime{0};           //Time spent running processes
+    double efficiency{1};                       //Fraction of busy CPU time spent running processes
+};
+
+//CPU scheduling policies for the processes in the ready queue. Real-time processes are always scheduled earliest-deadline-first.
+struct RoundRobinScheduling
+{
+    bool preemptsOnTimer() const { return true; }   //The running process goes to the back of the ready queue when its time slice ends
+};
+
+struct FCFSScheduling
+{
+    bool preemptsOnTimer() const { return false; }  //The running process keeps the CPU until it exits, waits or is preempted by a real-time job
+};
 
 class CPUManager
 {
@@ -18,20 +52,132 @@ public:
 
     //Setters
     void setReadyQueue(const std::deque<int>& readyQueue);
+    void setTimeQuantum(const unsigned long long& timeQuantum);
+    void setContextSwitchCost(const ContextSwitchCost& cost);
 
     //Getters
     bool isBusy() const;
     int getCurrentProcessID() const;
     std::deque<int> getReadyQueue() const;
+    unsigned long long getCurrentTime() const;
+    unsigned long long getTimeQuantum() const;
+    const SchedulingStats& getStats() const;
+    ProcessMetrics getProcessMetrics(const int& processID) const;
+    ContextSwitchCost getContextSwitchCost() const;
+    ContextSwitchReport getContextSwitchReport() const;
+    bool hasReadyProcess() const;
+    bool hasRealTimeProcesses() const;
+    bool isRealTimeProcess(const int& processID) const;
+    bool isWaitingForRelease(const int& processID) const;
+    std::vector<int> getRealTimeQueue() const;
+    std::vector<int> getReleasedProcesses() const;
+    RealTimeReport getRealTimeReport() const;
 
     //Utility Functions
     int addProcess(const int& process);
+    int addProcesses(const int& firstProcess, const unsigned int& count);
+    bool admitRealTimeProcess(const int& process, const RealTimeParameters& parameters);
     std::pair<int, int> runFirstProcess();
     void killRunningProcess();
+    template <class Predicate>
+    void removeFromReadyQueue(const Predicate& shouldRemove);
     std::pair<int, int> timerInterrupt();
+    std::pair<int, int> timerInterrupt(const unsigned long long& count);
+    template <class Scheduler>
+    std::pair<int, int> timerInterrupt(const Scheduler& scheduler);
+    template <class Scheduler>
+    std::pair<int, int> timerInterrupt(const Scheduler& scheduler, const unsigned long long& count);
+
+    //Scheduling Metrics
+    void recordArrival(const int& processID);
+    void recordArrivals(const int& firstProcessID, const unsigned int& count);
+    void recordBlocked(const int& processID, const bool& onDiskIO);
+    void recordUnblocked(const int& processID);
+    void recordMemoryAccess(const int& processID, const bool& pageFault);
+    void recordCompletion(const int& processID);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
 private:
+    bool endTimeSlice(std::pair<int, int>& newCurrentProcess);
+    std::pair<int, int> rotateReadyQueue();
+    std::pair<int, int> rotateReadyQueue(const unsigned long long& count);
+    void extendTimeSlice(const unsigned long long& count);
+    void dispatch(const int& process);
+    unsigned long long chargeContextSwitch(const int& process);
+    bool hasSteadySwitchCost(const unsigned long long& cycleLength) const;
+
     std::deque<int> readyQueue_;
     int currentProcess_;
+    unsigned long long currentTime_;    //Simulated time, advanced by one time quantum on every timer interrupt and by the cost of every context switch
+    unsigned long long timeQuantum_;
+    SchedulingStats stats_;
+
+    ContextSwitchCost switchCost_;
+    ContextSwitchReport switchReport_;
+    int lastRunProcess_;                                        //The process whose state is loaded on the CPU, even while it is idle
+    std::unordered_map<int, unsigned long long> lastRunTime_;   //Time each process last left the CPU
+
+    EDFScheduler realTime_;                 //Real-time processes, which always run before the processes in the ready queue
+    std::vector<int> releasedProcesses_;    //Real-time processes woken up by the last timer interrupt
 };
 
+/*
+    @param  A const lvalue reference to a function that takes a PID and returns true if the process has to leave the ready queue.
+    @post   Every such process is removed from the ready queue in one sweep. The order of the remaining processes is kept.
+*/
+template <class Predicate>
+void CPUManager::removeFromReadyQueue(const Predicate& shouldRemove)
+{
+    readyQueue_.erase(std::remove_if(readyQueue_.begin(), readyQueue_.end(), shouldRemove), readyQueue_.end());
+}
+
+/*
+    @param  A const lvalue reference to the scheduling policy of the ready queue.
+    @post   The time slice of the running process ends and real-time jobs are handled as in timerInterrupt().
+            If the real-time class leaves the decision to the ready queue, the policy decides whether the running process is preempted.
+            The policy is a template parameter so its decision is inlined into the interrupt.
+    @return An std::pair object with the first element being the PID of the current Process and the second element being the state of the current process.
+*/
+template <class Scheduler>
+std::pair<int, int> CPUManager::timerInterrupt(const Scheduler& scheduler)
+{
+    std::pair<int, int> newCurrentProcess;
+    if (endTimeSlice(newCurrentProcess))
+        return newCurrentProcess;
+
+    if (!scheduler.preemptsOnTimer() || readyQueue_.empty())
+        return std::make_pair(currentProcess_, RUNNING);    //The interrupted process keeps the CPU without a switch
+    return rotateReadyQueue();
+}
+
+/*
+    @param  A const lvalue reference to the scheduling policy of the ready queue.
+    @param  The number of timer interrupts to apply.
+    @post   Same as calling timerInterrupt(scheduler) count times.
+            Without real-time processes, a preempting policy rotates the ready queue arithmetically and a non-preempting one extends the running time slice.
+    @return An std::pair object with the first element being the PID of the current Process and the second element being the state of the current process.
+*/
+template <class Scheduler>
+std::pair<int, int> CPUManager::timerInterrupt(const Scheduler& scheduler, const unsigned long long& count)
+{
+    std::pair<int, int> newCurrentProcess = std::make_pair(currentProcess_, RUNNING);
+    if (count == 0 || currentProcess_ == NO_PROCESS)
+        return newCurrentProcess;
+
+    if (!realTime_.isEmpty())
+    {
+        for (unsigned long long i = 0; i < count && currentProcess_ != NO_PROCESS; i++)
+            newCurrentProcess = timerInterrupt(scheduler);
+        return newCurrentProcess;
+    }
+
+    if (scheduler.preemptsOnTimer())
+        return rotateReadyQueue(count);
+
+    extendTimeSlice(count);
+    return newCurrentProcess;
+}
+
 #endif
\ No newline at end of file
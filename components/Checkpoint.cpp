@@ -0,0 +1,173 @@
+// Alan Tuecci
+#include "Checkpoint.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the path of the checkpoint file.
+    @post   The file is created or truncated and the header is written.
+
+    @note   If the file can't be opened for writing, throw std::runtime_error exception.
+*/
+CheckpointWriter::CheckpointWriter(const std::string& path):
+    file_{path, std::ios::binary | std::ios::trunc},
+    offset_{0}
+{
+    if (!file_)
+        throw std::runtime_error("The checkpoint file could not be opened for writing");
+    writeBytes(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    write(CHECKPOINT_VERSION);
+    write(CHECKPOINT_BYTE_ORDER);
+}
+
+/*
+    @param  A const lvalue reference to the path of the checkpoint file.
+    @post   The header is read and checked.
+
+    @note   If the file can't be opened, isn't a checkpoint, or has another version or byte order, throw std::runtime_error exception.
+*/
+CheckpointReader::CheckpointReader(const std::string& path):
+    file_{path, std::ios::binary},
+    offset_{0}
+{
+    if (!file_)
+        throw std::runtime_error("The checkpoint file could not be opened for reading");
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    readBytes(magic, sizeof(magic));
+    if (std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+        throw std::runtime_error("The file is not a simulator checkpoint");
+    if (read<std::uint32_t>() != CHECKPOINT_VERSION)
+        throw std::runtime_error("The checkpoint was written by an unsupported version");
+    if (read<std::uint32_t>() != CHECKPOINT_BYTE_ORDER)
+        throw std::runtime_error("The checkpoint was written with a different byte order");
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  A tag of up to 8 characters naming the section that follows.
+    @post   The tag is appended to the file, padded with zeros to 8 bytes.
+
+    @note   If the tag is longer than 8 characters, throw std::invalid_argument exception.
+*/
+void CheckpointWriter::writeTag(const char* tag)
+{
+    std::size_t length = std::strlen(tag);
+    if (length > CHECKPOINT_ALIGNMENT)
+        throw std::invalid_argument("A checkpoint tag has at most 8 characters");
+    char bytes[CHECKPOINT_ALIGNMENT]{};
+    std::memcpy(bytes, tag, length);
+    writeBytes(bytes, sizeof(bytes));
+}
+
+/*
+    @param  A const lvalue reference to a string.
+    @post   The length and the characters of the string are appended to the file, padded to 8 bytes.
+*/
+void CheckpointWriter::writeString(const std::string& value)
+{
+    std::uint64_t length = value.size();
+    writeBytes(&length, sizeof(length));
+    writeBytes(value.data(), value.size());
+    pad();
+}
+
+/*
+    @post   Everything written is flushed to the file.
+
+    @note   If writing failed, throw std::runtime_error exception.
+*/
+void CheckpointWriter::finish()
+{
+    writeTag("END");
+    file_.flush();
+    if (!file_)
+        throw std::runtime_error("The checkpoint file could not be written");
+}
+
+/*
+    @param  A pointer to the bytes to append.
+    @param  The number of bytes.
+    @post   The bytes are appended to the file.
+
+    @note   If writing failed, throw std::runtime_error exception.
+*/
+void CheckpointWriter::writeBytes(const void* bytes, const std::size_t& size)
+{
+    file_.write(static_cast<const char*>(bytes), size);
+    if (!file_)
+        throw std::runtime_error("The checkpoint file could not be written");
+    offset_ += size;
+}
+
+/*
+    @post   Zeros are appended until the file is aligned to 8 bytes.
+*/
+void CheckpointWriter::pad()
+{
+    static const char zeros[CHECKPOINT_ALIGNMENT]{};
+    if (offset_ % CHECKPOINT_ALIGNMENT != 0)
+        writeBytes(zeros, CHECKPOINT_ALIGNMENT - offset_ % CHECKPOINT_ALIGNMENT);
+}
+
+/*
+    @param  The tag of up to 8 characters the next section is expected to start with.
+    @post   The tag is read.
+
+    @note   If the tag is longer than 8 characters, throw std::invalid_argument exception.
+    @note   If the file has a different tag there, it is corrupt or out of step, so throw std::runtime_error exception.
+*/
+void CheckpointReader::expectTag(const char* tag)
+{
+    std::size_t length = std::strlen(tag);
+    if (length > CHECKPOINT_ALIGNMENT)
+        throw std::invalid_argument("A checkpoint tag has at most 8 characters");
+    char expected[CHECKPOINT_ALIGNMENT]{};
+    std::memcpy(expected, tag, length);
+    char found[CHECKPOINT_ALIGNMENT];
+    readBytes(found, sizeof(found));
+    if (std::memcmp(expected, found, sizeof(found)) != 0)
+        throw std::runtime_error("The checkpoint is corrupt: expected section " + std::string(tag));
+}
+
+/*
+    @return The next string in the file.
+
+    @note   If the file ends early, throw std::runtime_error exception.
+*/
+std::string CheckpointReader::readString()
+{
+    std::uint64_t length{0};
+    readBytes(&length, sizeof(length));
+    std::string value(length, '\0');
+    if (length > 0)
+        readBytes(&value[0], length);
+    skipPadding();
+    return value;
+}
+
+/*
+    @param  A pointer to where the bytes go.
+    @param  The number of bytes.
+    @post   The next bytes of the file are copied.
+
+    @note   If the file ends early, throw std::runtime_error exception.
+*/
+void CheckpointReader::readBytes(void* bytes, const std::size_t& size)
+{
+    file_.read(static_cast<char*>(bytes), size);
+    if (static_cast<std::size_t>(file_.gcount()) != size)
+        throw std::runtime_error("The checkpoint file ended early");
+    offset_ += size;
+}
+
+/*
+    @post   The padding up to the next 8 byte boundary is skipped.
+*/
+void CheckpointReader::skipPadding()
+{
+    char padding[CHECKPOINT_ALIGNMENT];
+    if (offset_ % CHECKPOINT_ALIGNMENT != 0)
+        readBytes(padding, CHECKPOINT_ALIGNMENT - offset_ % CHECKPOINT_ALIGNMENT);
+}
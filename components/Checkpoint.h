@@ -0,0 +1,132 @@
+// Alan Tuecci
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+constexpr char CHECKPOINT_MAGIC[8]{'S', 'I', 'M', 'O', 'S', 'C', 'K', 'P'};
+constexpr std::uint32_t CHECKPOINT_VERSION{15};
+constexpr std::uint32_t CHECKPOINT_BYTE_ORDER{0x01020304};  //Written as-is, so a checkpoint from a machine with the other byte order is detected
+constexpr unsigned int CHECKPOINT_ALIGNMENT{8};
+
+/*
+    Binary checkpoint file layout:
+    a header (magic, version, byte order marker), followed by sections that each start with an 8 byte tag.
+    Values are stored as raw bytes and arrays as an element count and element size followed by the raw elements,
+    and everything is padded to 8 bytes, so every array starts aligned and could be used in place from a memory mapped file.
+*/
+class CheckpointWriter
+{
+public:
+    //Constructors
+    explicit CheckpointWriter(const std::string& path);
+
+    //Utilities
+    void writeTag(const char* tag);
+    template <class T>
+    void write(const T& value);
+    template <class T>
+    void writeArray(const std::vector<T>& values);
+    void writeString(const std::string& value);
+    void finish();
+private:
+    void writeBytes(const void* bytes, const std::size_t& size);
+    void pad();
+
+    std::ofstream file_;
+    unsigned long long offset_;
+};
+
+class CheckpointReader
+{
+public:
+    //Constructors
+    explicit CheckpointReader(const std::string& path);
+
+    //Utilities
+    void expectTag(const char* tag);
+    template <class T>
+    T read();
+    template <class T>
+    void readArray(std::vector<T>& values);
+    std::string readString();
+private:
+    void readBytes(void* bytes, const std::size_t& size);
+    void skipPadding();
+
+    std::ifstream file_;
+    unsigned long long offset_;
+};
+
+/*
+    @param  A const lvalue reference to a value whose bytes fully describe it.
+    @post   The value is appended to the file, padded to 8 bytes.
+*/
+template <class T>
+void CheckpointWriter::write(const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written as raw bytes");
+    writeBytes(&value, sizeof(T));
+    pad();
+}
+
+/*
+    @param  A const lvalue reference to a vector of values whose bytes fully describe them.
+    @post   The element count, the element size and the elements are appended to the file, padded to 8 bytes.
+*/
+template <class T>
+void CheckpointWriter::writeArray(const std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written as raw bytes");
+    std::uint64_t count = values.size();
+    std::uint64_t elementSize = sizeof(T);
+    writeBytes(&count, sizeof(count));
+    writeBytes(&elementSize, sizeof(elementSize));
+    if (count > 0)
+        writeBytes(values.data(), count * sizeof(T));
+    pad();
+}
+
+/*
+    @return The next value in the file.
+
+    @note   If the file ends early, throw std::runtime_error exception.
+*/
+template <class T>
+T CheckpointReader::read()
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read as raw bytes");
+    T value;
+    readBytes(&value, sizeof(T));
+    skipPadding();
+    return value;
+}
+
+/*
+    @param  A reference to the vector that receives the next array in the file.
+    @post   The vector holds exactly the elements of the array, read in one block.
+
+    @note   If the array was written with a different element size or the file ends early, throw std::runtime_error exception.
+*/
+template <class T>
+void CheckpointReader::readArray(std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read as raw bytes");
+    std::uint64_t count{0};
+    std::uint64_t elementSize{0};
+    readBytes(&count, sizeof(count));
+    readBytes(&elementSize, sizeof(elementSize));
+    if (elementSize != sizeof(T))
+        throw std::runtime_error("The checkpoint was written with a different data layout");
+
+    values.resize(count);
+    if (count > 0)
+        readBytes(values.data(), count * sizeof(T));
+    skipPadding();
+}
+#endif
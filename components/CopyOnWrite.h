@@ -0,0 +1,200 @@
+// Alan Tuecci
+#ifndef COPYONWRITE_H
+#define COPYONWRITE_H
+#include <vector>
+#include <array>
+#include <memory>
+#include <algorithm>
+#include "Checkpoint.h"
+
+/*
+    Handle to an object that is shared between copies of the handle until one of them changes it.
+    Reading goes through operator-> and never copies. write() gives the handle its own copy first if the object is shared.
+    The sharing is not synchronized, so copies must stay on one thread.
+*/
+template <class T>
+class CopyOnWrite
+{
+public:
+    //Constructors
+    CopyOnWrite(): object_{std::make_shared<T>()} {}
+    explicit CopyOnWrite(T object): object_{std::make_shared<T>(std::move(object))} {}
+
+    //Getters
+    const T& operator*() const { return *object_; }
+    const T* operator->() const { return object_.get(); }
+
+    //Utilities
+    T& write();
+private:
+    std::shared_ptr<T> object_;
+};
+
+/*
+    @return A reference to the object that only this handle uses.
+            The object is copied if another handle still shares it.
+*/
+template <class T>
+T& CopyOnWrite<T>::write()
+{
+    if (object_.use_count() > 1)
+        object_ = std::make_shared<T>(*object_);
+    return *object_;
+}
+
+/*
+    Vector stored as chunks of 2^CHUNK_BITS elements that are shared between copies of the vector.
+    Copying the vector only copies the chunk pointers; a chunk is copied the first time an element in it is written through a copy,
+    so a copy costs memory in proportion to the chunks it changes.
+    The non-const operator[] counts as a write, so read through a const reference where nothing changes.
+    The sharing is not synchronized, so copies must stay on one thread.
+*/
+template <class T, unsigned int CHUNK_BITS = 10>
+class ChunkedVector
+{
+public:
+    static constexpr std::size_t CHUNK_SIZE{std::size_t{1} << CHUNK_BITS};
+
+    //Constructors
+    ChunkedVector(): chunks_{}, size_{0} {}
+    ChunkedVector(const std::size_t& count, const T& value): chunks_{}, size_{0} { resize(count, value); }
+
+    //Getters
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T& operator[](const std::size_t& index) const { return (*chunks_[index >> CHUNK_BITS])[index & (CHUNK_SIZE - 1)]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+    std::vector<T> toVector() const;
+
+    //Utilities
+    T& operator[](const std::size_t& index) { return writableChunk(index >> CHUNK_BITS)[index & (CHUNK_SIZE - 1)]; }
+    void push_back(const T& value);
+    void pop_back() { resize(size_ - 1); }
+    void resize(const std::size_t& count, const T& value = T());
+    void assign(const std::vector<T>& values);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    using Chunk = std::array<T, CHUNK_SIZE>;
+
+    T* writableChunk(const std::size_t& chunk);
+
+    std::vector<std::shared_ptr<Chunk>> chunks_;
+    std::size_t size_;
+};
+
+//Out-of-class definition, needed before C++17 since std::min binds CHUNK_SIZE by reference
+template <class T, unsigned int CHUNK_BITS>
+constexpr std::size_t ChunkedVector<T, CHUNK_BITS>::CHUNK_SIZE;
+
+/*
+    @return A contiguous copy of the elements.
+*/
+template <class T, unsigned int CHUNK_BITS>
+std::vector<T> ChunkedVector<T, CHUNK_BITS>::toVector() const
+{
+    std::vector<T> values;
+    values.reserve(size_);
+    for (std::size_t chunk = 0; chunk < chunks_.size(); chunk++)
+    {
+        std::size_t count = std::min(CHUNK_SIZE, size_ - chunk * CHUNK_SIZE);
+        values.insert(values.end(), chunks_[chunk]->begin(), chunks_[chunk]->begin() + count);
+    }
+    return values;
+}
+
+/*
+    @param  A const lvalue reference to the new last element.
+    @post   The element is appended, adding a chunk if the last one is full.
+*/
+template <class T, unsigned int CHUNK_BITS>
+void ChunkedVector<T, CHUNK_BITS>::push_back(const T& value)
+{
+    if (size_ == chunks_.size() * CHUNK_SIZE)
+        chunks_.push_back(std::make_shared<Chunk>());
+    writableChunk(size_ >> CHUNK_BITS)[size_ & (CHUNK_SIZE - 1)] = value;
+    size_++;
+}
+
+/*
+    @param  A const lvalue reference to the new number of elements.
+    @param  A const lvalue reference to the value of any added elements.
+    @post   The vector has the requested number of elements. Chunks that are no longer needed are released.
+*/
+template <class T, unsigned int CHUNK_BITS>
+void ChunkedVector<T, CHUNK_BITS>::resize(const std::size_t& count, const T& value)
+{
+    std::size_t chunkCount = (count + CHUNK_SIZE - 1) >> CHUNK_BITS;
+    if (count > size_)
+    {
+        if (size_ % CHUNK_SIZE != 0)
+        {
+            T* last = writableChunk(size_ >> CHUNK_BITS);
+            std::fill(last + (size_ & (CHUNK_SIZE - 1)), last + std::min(CHUNK_SIZE, count - (size_ & ~(CHUNK_SIZE - 1))), value);
+        }
+        chunks_.reserve(chunkCount);
+        while (chunks_.size() < chunkCount)
+        {
+            std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+            chunk->fill(value);
+            chunks_.push_back(std::move(chunk));
+        }
+    }
+    else
+        chunks_.resize(chunkCount);
+    size_ = count;
+}
+
+/*
+    @param  A const lvalue reference to the new elements.
+    @post   The vector holds exactly the new elements in its own chunks.
+*/
+template <class T, unsigned int CHUNK_BITS>
+void ChunkedVector<T, CHUNK_BITS>::assign(const std::vector<T>& values)
+{
+    chunks_.clear();
+    size_ = 0;
+    resize(values.size());
+    for (std::size_t chunk = 0; chunk < chunks_.size(); chunk++)
+    {
+        std::size_t first = chunk * CHUNK_SIZE;
+        std::copy(values.begin() + first, values.begin() + std::min(values.size(), first + CHUNK_SIZE), chunks_[chunk]->begin());
+    }
+}
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The elements are appended to the checkpoint as one contiguous array.
+*/
+template <class T, unsigned int CHUNK_BITS>
+void ChunkedVector<T, CHUNK_BITS>::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.writeArray(toVector());
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The vector holds the elements of the next array in the checkpoint.
+*/
+template <class T, unsigned int CHUNK_BITS>
+void ChunkedVector<T, CHUNK_BITS>::readCheckpoint(CheckpointReader& reader)
+{
+    std::vector<T> values;
+    reader.readArray(values);
+    assign(values);
+}
+
+/*
+    @param  A const lvalue reference to the index of a chunk.
+    @return A pointer to the elements of the chunk, which is copied first if another vector still shares it.
+*/
+template <class T, unsigned int CHUNK_BITS>
+T* ChunkedVector<T, CHUNK_BITS>::writableChunk(const std::size_t& chunk)
+{
+    if (chunks_[chunk].use_count() > 1)
+        chunks_[chunk] = std::make_shared<Chunk>(*chunks_[chunk]);
+    return chunks_[chunk]->data();
+}
+#endif
@@ -1,88 +1,586 @@
 // Alan Tuecci
 #include "DiskManager.h"
 
+//--------------------------------------------Disk Queue--------------------------------------------
+
+/*
+    @param  A const lvalue reference to a cylinder.
+    @param  A reference that receives the key of the oldest request on the lowest cylinder at or above the given one.
+    @return True if there is such a request.
+*/
+bool DiskQueue::findAtOrAbove(const unsigned long long& cylinder, Key& key) const
+{
+    std::set<Key>::const_iterator request = byCylinder_.lower_bound(Key{cylinder, 0});
+    if (request == byCylinder_.end())
+        return false;
+    key = *request;
+    return true;
+}
+
+/*
+    @param  A const lvalue reference to a cylinder.
+    @param  A reference that receives the key of the oldest request on the highest cylinder at or below the given one.
+    @return True if there is such a request.
+*/
+bool DiskQueue::findAtOrBelow(const unsigned long long& cylinder, Key& key) const
+{
+    std::set<Key>::const_iterator request = byCylinder_.upper_bound(Key{cylinder, ~0ull});
+    if (request == byCylinder_.begin())
+        return false;
+    key = oldestOn((--request)->first);
+    return true;
+}
+
+/*
+    @return The waiting requests in arrival order.
+*/
+std::deque<DiskRequest> DiskQueue::toDeque() const
+{
+    std::deque<DiskRequest> requests;
+    for (const std::pair<const unsigned long long, DiskRequest>& request : byArrival_)
+        requests.push_back(request.second);
+    return requests;
+}
+
+/*
+    @param  A const lvalue reference to the request.
+    @post   The request is added as the newest one.
+*/
+void DiskQueue::push(const DiskRequest& request)
+{
+    byArrival_.emplace_hint(byArrival_.end(), nextArrival_, request);
+    byCylinder_.insert(Key{request.cylinder, nextArrival_});
+    byProcess_.emplace(request.PID, Key{request.cylinder, nextArrival_});
+    nextArrival_++;
+}
+
+/*
+    @param  A const lvalue reference to the key of a waiting request.
+    @post   The request is removed from the queue.
+    @return The request.
+*/
+DiskRequest DiskQueue::take(const Key& key)
+{
+    std::map<unsigned long long, DiskRequest>::iterator request = byArrival_.find(key.second);
+    DiskRequest taken = request->second;
+    byArrival_.erase(request);
+    byCylinder_.erase(key);
+    std::pair<std::unordered_multimap<int, Key>::iterator, std::unordered_multimap<int, Key>::iterator> requests = byProcess_.equal_range(taken.PID);
+    for (std::unordered_multimap<int, Key>::iterator i = requests.first; i != requests.second; i++)
+    {
+        if (i->second == key)
+        {
+            byProcess_.erase(i);
+            break;
+        }
+    }
+    return taken;
+}
+
+/*
+    @param  A const lvalue reference to a PID.
+    @post   Every waiting request of the process is removed from the queue, in time proportional to their number.
+    @return The number of requests removed.
+*/
+std::size_t DiskQueue::removeProcess(const int& PID)
+{
+    std::pair<std::unordered_multimap<int, Key>::iterator, std::unordered_multimap<int, Key>::iterator> requests = byProcess_.equal_range(PID);
+    std::size_t removed{0};
+    for (std::unordered_multimap<int, Key>::iterator i = requests.first; i != requests.second; i++)
+    {
+        byArrival_.erase(i->second.second);
+        byCylinder_.erase(i->second);
+        removed++;
+    }
+    byProcess_.erase(requests.first, requests.second);
+    return removed;
+}
+
+//--------------------------------------------Disk Scheduling Policies--------------------------------------------
+
+/*
+    @param  A const lvalue reference to a non-empty disk queue.
+    @param  A reference to the head of the disk.
+    @return The key of the request closest to the head. On a tie, the one that arrived first.
+*/
+DiskQueue::Key SSTFDiskScheduling::selectNext(const DiskQueue& diskQueue, DiskHead& head) const
+{
+    DiskQueue::Key above;
+    DiskQueue::Key below;
+    if (!diskQueue.findAtOrAbove(head.cylinder, above))
+    {
+        diskQueue.findAtOrBelow(head.cylinder, below);
+        return below;
+    }
+    if (!diskQueue.findAtOrBelow(head.cylinder, below))
+        return above;
+    unsigned long long distanceAbove = above.first - head.cylinder;
+    unsigned long long distanceBelow = head.cylinder - below.first;
+    if (distanceAbove != distanceBelow)
+        return distanceAbove < distanceBelow ? above : below;
+    return above.second < below.second ? above : below;
+}
+
+/*
+    @param  A const lvalue reference to a non-empty disk queue.
+    @param  A reference to the head of the disk.
+    @post   If no request is left in the direction of the sweep, the head travels to that edge of the disk and reverses.
+    @return The key of the next request in the direction of the sweep.
+*/
+DiskQueue::Key SCANDiskScheduling::selectNext(const DiskQueue& diskQueue, DiskHead& head) const
+{
+    DiskQueue::Key next;
+    if (head.movingUp)
+    {
+        if (diskQueue.findAtOrAbove(head.cylinder, next))
+            return next;
+        head.seek(DEFAULT_DISK_CYLINDERS - 1);
+        head.movingUp = false;
+        return diskQueue.highest();
+    }
+    if (diskQueue.findAtOrBelow(head.cylinder, next))
+        return next;
+    head.seek(0);
+    head.movingUp = true;
+    return diskQueue.lowest();
+}
+
+/*
+    @param  A const lvalue reference to a non-empty disk queue.
+    @param  A reference to the head of the disk.
+    @post   If no request is left above the head, the head travels to the last cylinder and returns to cylinder 0.
+    @return The key of the next request at or above the head.
+*/
+DiskQueue::Key CSCANDiskScheduling::selectNext(const DiskQueue& diskQueue, DiskHead& head) const
+{
+    DiskQueue::Key next;
+    if (diskQueue.findAtOrAbove(head.cylinder, next))
+        return next;
+    head.seek(DEFAULT_DISK_CYLINDERS - 1);
+    head.seek(0);
+    return diskQueue.lowest();
+}
+
+/*
+    @param  A const lvalue reference to a non-empty disk queue.
+    @param  A reference to the head of the disk.
+    @return The key of the next request at or above the head, or of the lowest request if there is none above it.
+*/
+DiskQueue::Key CLOOKDiskScheduling::selectNext(const DiskQueue& diskQueue, DiskHead& head) const
+{
+    DiskQueue::Key next;
+    if (diskQueue.findAtOrAbove(head.cylinder, next))
+        return next;
+    return diskQueue.lowest();
+}
+
 //--------------------------------------------Constructors--------------------------------------------
 
 /*
     @post   Disk Manager object initialized with placeholder values.
 */
-DiskManager::DiskManager() : diskQueue_{}
+DiskManager::DiskManager() :
+    slots_(1),
+    slotStarted_(1, 0),
+    hardwareQueues_(1),
+    nextQueue_{0},
+    head_{},
+    requestsServed_{0},
+    serviceModel_{},
+    clock_{0},
+    busyTime_{0},
+    requestsCancelled_{0},
+    timeReclaimed_{0},
+    queueDepth_{},
+    waitTime_{},
+    serviceTime_{},
+    responseTime_{}
 {
-    FileReadRequest noJobFile{0, ""};
-    currentJob_ = noJobFile;
 }
 
 //--------------------------------------------Setters--------------------------------------------
 
 /*
-    @param  A const lvalue reference to deque of pairs of FileReadRequest and Process objects.
-    @post   The disk queue is updated to be an exact copy of the parameter.
+    @param  A const lvalue reference to deque of DiskRequest objects.
+    @post   The waiting requests are replaced by the requests of the parameter, each in the hardware queue of its process.
 */
-void DiskManager::setDiskQueue(const std::deque<FileReadRequest> &diskQueue)
+void DiskManager::setDiskQueue(const std::deque<DiskRequest> &diskQueue)
 {
-    diskQueue_ = diskQueue;
+    for (DiskQueue& hardwareQueue : hardwareQueues_)
+        hardwareQueue.clear();
+    for (const DiskRequest& request : diskQueue)
+        hardwareQueues_[request.PID % hardwareQueues_.size()].push(request);
 }
 
 /*
-    @param  A const lvalue reference to a FileReadRequest object.
-    @post   The current FileReadRequest object is updated to be an exact copy of the parameter.
+    @param  A const lvalue reference to a DiskRequest object.
+    @post   The request in the first slot is updated to be an exact copy of the parameter.
 */
-void DiskManager::setCurrentFileReadRequest(const FileReadRequest &fileReadRequest)
+void DiskManager::setCurrentDiskRequest(const DiskRequest &request)
 {
-    currentJob_ = fileReadRequest;
+    slots_[0] = request;
+}
+
+/*
+    @param  A const lvalue reference to the service model.
+    @post   Requests started from now on take the time the model gives them.
+*/
+void DiskManager::setServiceModel(const DiskServiceModel& serviceModel)
+{
+    serviceModel_ = serviceModel;
+}
+
+/*
+    @param  A const lvalue reference to the number of hardware queues, at least 1.
+    @param  A const lvalue reference to the number of requests the disk serves at once, at least 1.
+    @post   The disk has the given hardware queues and in-flight slots. Only an idle disk is reconfigured; the caller checks that it is.
+*/
+void DiskManager::setParallelism(const unsigned int& hardwareQueues, const unsigned int& slots)
+{
+    slots_.assign(slots, DiskRequest{});
+    slotStarted_.assign(slots, 0);
+    hardwareQueues_.assign(hardwareQueues, DiskQueue{});
+    nextQueue_ = 0;
 }
 
 //--------------------------------------------Getters--------------------------------------------
 
 /*
-    @return The disk queue.
+    @return The waiting requests, hardware queue by hardware queue, each in arrival order. With one hardware queue, this is the arrival order.
+*/
+std::deque<DiskRequest> DiskManager::getDiskQueue() const
+{
+    std::deque<DiskRequest> diskQueue;
+    for (const DiskQueue& hardwareQueue : hardwareQueues_)
+    {
+        std::deque<DiskRequest> requests = hardwareQueue.toDeque();
+        diskQueue.insert(diskQueue.end(), requests.begin(), requests.end());
+    }
+    return diskQueue;
+}
+
+/*
+    @return The request that has been in flight the longest, or the default DiskRequest if the disk is idle.
+*/
+DiskRequest DiskManager::getCurrentDiskRequest() const
+{
+    return slots_[getOldestSlot()];
+}
+
+/*
+    @param  A const lvalue reference to the number of an existing slot.
+    @return The request in flight in the slot, or the default DiskRequest if the slot is free.
+*/
+DiskRequest DiskManager::getDiskRequest(const unsigned int& slot) const
+{
+    return slots_[slot];
+}
+
+/*
+    @return The slot whose request has been in flight the longest, or slot 0 if every slot is free.
+*/
+unsigned int DiskManager::getOldestSlot() const
+{
+    unsigned int oldest{0};
+    bool found{false};
+    for (unsigned int slot = 0; slot < slots_.size(); slot++)
+    {
+        if (slots_[slot].PID != 0 && (!found || slotStarted_[slot] < slotStarted_[oldest]))
+        {
+            oldest = slot;
+            found = true;
+        }
+    }
+    return oldest;
+}
+
+/*
+    @return The number of requests the disk serves at once.
+*/
+unsigned int DiskManager::getSlotCount() const
+{
+    return static_cast<unsigned int>(slots_.size());
+}
+
+/*
+    @return The number of hardware queues requests wait in.
+*/
+unsigned int DiskManager::getHardwareQueueCount() const
+{
+    return static_cast<unsigned int>(hardwareQueues_.size());
+}
+
+/*
+    @return True if no request is in flight or waiting.
+*/
+bool DiskManager::isIdle() const
+{
+    return getQueueDepth() == 0;
+}
+
+/*
+    @return The position and sweep direction of the head, with the distance it travelled.
+*/
+DiskHead DiskManager::getHead() const
+{
+    return head_;
+}
+
+/*
+    @return The number of requests served and the distance the head travelled to serve them.
+*/
+DiskSeekStats DiskManager::getSeekStats() const
+{
+    DiskSeekStats stats;
+    stats.requestsServed = requestsServed_;
+    stats.seekDistance = head_.seekDistance;
+    if (requestsServed_ != 0)
+        stats.meanSeekDistance = static_cast<double>(head_.seekDistance) / requestsServed_;
+    stats.headCylinder = head_.cylinder;
+    return stats;
+}
+
+/*
+    @return The service model of the disk.
 */
-std::deque<FileReadRequest> DiskManager::getDiskQueue() const
+DiskServiceModel DiskManager::getServiceModel() const
 {
-    return diskQueue_;
+    return serviceModel_;
 }
 
 /*
-    @return The current FileReadRequest object.
+    @param  A const lvalue reference to the current simulated time.
+    @return The busy time and utilization of the disk, with the distributions of its queue depth and of the wait, service and response times of its requests.
 */
-FileReadRequest DiskManager::getCurrentFileReadRequest() const
+DiskReport DiskManager::getReport(const unsigned long long& currentTime) const
 {
-    return currentJob_;
+    DiskReport report;
+    report.requestsStarted = requestsServed_;
+    report.busyTime = busyTime_;
+    if (currentTime != 0)
+        report.utilization = static_cast<double>(busyTime_) / (currentTime * slots_.size());
+    else if (busyTime_ != 0)
+        report.utilization = 1;
+    report.queueDepth = queueDepth_.getSummary();
+    report.waitTime = waitTime_.getSummary();
+    report.serviceTime = serviceTime_.getSummary();
+    report.responseTime = responseTime_.getSummary();
+    report.requestsCancelled = requestsCancelled_;
+    report.timeReclaimed = timeReclaimed_;
+    return report;
+}
+
+/*
+    @return The number of requests at the disk, waiting or being served.
+*/
+unsigned long long DiskManager::getQueueDepth() const
+{
+    return waitingRequests() + std::count_if(slots_.begin(), slots_.end(), [](const DiskRequest& request) { return request.PID != 0; });
+}
+
+/*
+    @return The mean modeled service time of the requests the disk has started, rounded to the nearest time unit.
+*/
+unsigned long long DiskManager::getMeanServiceTime() const
+{
+    return static_cast<unsigned long long>(serviceTime_.getMean() + 0.5);
+}
+
+/*
+    @return The requests at the disk and the expected time until a request made now would be done: the rounds of the slots it waits for,
+            and its own, times the mean service time of the requests the disk started, or the model's service time without a seek if it started none.
+*/
+DiskLoad DiskManager::getLoad() const
+{
+    DiskLoad load;
+    load.queueDepth = getQueueDepth();
+    load.expectedCompletionTime = (load.queueDepth / slots_.size() + 1) * expectedServiceTime();
+    return load;
+}
+
+/*
+    @param  A const lvalue reference to a PID.
+    @return True if the process has requests waiting at the disk. Only the hardware queue of the process is looked at.
+*/
+bool DiskManager::hasWaitingRequests(const int& PID) const
+{
+    return hardwareQueues_[PID % hardwareQueues_.size()].contains(PID);
+}
+
+/*
+    @return The distribution of the response times of the requests the disk started, to merge with those of other disks.
+*/
+const Histogram& DiskManager::getResponseTimeHistogram() const
+{
+    return responseTime_;
 }
 
 //--------------------------------------------Utilities--------------------------------------------
 
 /*
-    @param  A const lvalue reference to a pair of FileReadRequests and Processes.
-    @post   The job is either handled immediately or is sent to the IO queue depending on whether or not theres already a job being handled.
+    @param  A const lvalue reference to a DiskRequest.
+    @post   The job is either handled immediately in the first free slot or is sent to the hardware queue of its process if every slot is busy.
 */
-void DiskManager::addToQueue(const FileReadRequest &job)
+void DiskManager::addToQueue(const DiskRequest &job)
 {
-    if(currentJob_.PID == 0)
-        currentJob_ = job;
+    clock_ = std::max(clock_, job.arrivalTime);
+    queueDepth_.record(getQueueDepth());
+    unsigned long long seekDistanceBefore = head_.seekDistance;
+    std::vector<DiskRequest>::const_iterator freeSlot = std::find_if(slots_.begin(), slots_.end(), [](const DiskRequest& request) { return request.PID == 0; });
+    if(freeSlot != slots_.end())
+        startJob(static_cast<unsigned int>(freeSlot - slots_.begin()), job, clock_, seekDistanceBefore);
     else
-        diskQueue_.push_back(job);
+        hardwareQueues_[job.PID % hardwareQueues_.size()].push(job);
 }
 
 /*
     @post   The next request is handled or if there are no waiting requests, then the current request is cleared.
+            Same as serving with the FCFSDiskScheduling policy.
 */
 void DiskManager::serveNextProcess()
 {
-    if(!diskQueue_.empty())
+    serveNextProcess(FCFSDiskScheduling());
+}
+
+/*
+    @param  A const lvalue reference to the PID of a terminated process.
+    @post   The waiting requests of the process are dropped from its hardware queue, in time proportional to their number,
+            and their expected service time is counted as reclaimed. A request already in flight is finished by the disk.
+*/
+void DiskManager::cancelRequests(const int& PID)
+{
+    std::size_t cancelled = hardwareQueues_[PID % hardwareQueues_.size()].removeProcess(PID);
+    requestsCancelled_ += cancelled;
+    timeReclaimed_ += cancelled * expectedServiceTime();
+}
+
+/*
+    @param  A const lvalue reference to the number of an existing slot.
+    @post   The request in the slot is cleared.
+*/
+void DiskManager::clearSlot(const unsigned int& slot)
+{
+    slots_[slot] = DiskRequest{};
+}
+
+/*
+    @param  A const lvalue reference to the number of a free slot.
+    @param  A const lvalue reference to the request to serve.
+    @post   The head seeks to the cylinder of the request, and the request is handled in the slot.
+*/
+void DiskManager::startJob(const unsigned int& slot, const DiskRequest& job, const unsigned long long& startTime, const unsigned long long& seekDistanceBefore)
+{
+    head_.seek(job.cylinder);
+    slots_[slot] = job;
+    slotStarted_[slot] = requestsServed_;
+    requestsServed_++;
+
+    unsigned long long wait = startTime > job.arrivalTime ? startTime - job.arrivalTime : 0;
+    unsigned long long service = serviceTime(head_.seekDistance - seekDistanceBefore, job.blockCount);
+    busyTime_ += service;
+    waitTime_.record(wait);
+    serviceTime_.record(service);
+    responseTime_.record(wait + service);
+}
+
+/*
+    @param  A const lvalue reference to the number of cylinders the head travelled to reach the request.
+    @param  A const lvalue reference to the number of consecutive blocks the request reads.
+    @return The time the service model takes to serve the request: one seek and rotational delay, then the transfer of every block.
+*/
+unsigned long long DiskManager::serviceTime(const unsigned long long& seekDistance, const unsigned long long& blockCount) const
+{
+    if (serviceModel_.fixedLatency != 0)
+        return serviceModel_.fixedLatency + serviceModel_.transferTime * blockCount;
+    unsigned long long seekTime{0};
+    if (seekDistance != 0)
+        seekTime = serviceModel_.seekSettleTime + static_cast<unsigned long long>(serviceModel_.seekTimePerCylinder * seekDistance + 0.5);
+    return seekTime + serviceModel_.rotationalDelay + serviceModel_.transferTime * blockCount;
+}
+
+/*
+    @return The mean service time of the requests the disk started, or the model's service time without a seek if it started none.
+*/
+unsigned long long DiskManager::expectedServiceTime() const
+{
+    return serviceTime_.getCount() != 0 ? getMeanServiceTime() : serviceTime(0, 1);
+}
+
+/*
+    @return The number of requests waiting in the hardware queues.
+*/
+std::size_t DiskManager::waitingRequests() const
+{
+    std::size_t waiting{0};
+    for (const DiskQueue& hardwareQueue : hardwareQueues_)
+        waiting += hardwareQueue.size();
+    return waiting;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The requests in flight, each hardware queue in arrival order, the head, and the service model with its statistics are appended to the checkpoint.
+*/
+void DiskManager::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.writeArray(slots_);
+    writer.writeArray(slotStarted_);
+    writer.write(static_cast<std::uint64_t>(hardwareQueues_.size()));
+    for (const DiskQueue& hardwareQueue : hardwareQueues_)
     {
-        currentJob_ = diskQueue_.front();
-        diskQueue_.pop_front();
+        std::deque<DiskRequest> requests = hardwareQueue.toDeque();
+        writer.writeArray(std::vector<DiskRequest>(requests.begin(), requests.end()));
     }
-    else
-        clearCurrentJob();
+    writer.write(nextQueue_);
+
+    writer.write(head_);
+    writer.write(requestsServed_);
+
+    writer.write(serviceModel_);
+    writer.write(clock_);
+    writer.write(busyTime_);
+    writer.write(requestsCancelled_);
+    writer.write(timeReclaimed_);
+    queueDepth_.writeCheckpoint(writer);
+    waitTime_.writeCheckpoint(writer);
+    serviceTime_.writeCheckpoint(writer);
+    responseTime_.writeCheckpoint(writer);
 }
 
 /*
-    @post   The current request is cleared.
+    @param  A reference to the checkpoint being read.
+    @post   The disk is in the state it was in when the checkpoint was written.
+
+    @note   If the disk has no slot or hardware queue, or the slots don't add up, throw std::runtime_error exception.
 */
-void DiskManager::clearCurrentJob()
+void DiskManager::readCheckpoint(CheckpointReader& reader)
 {
-    currentJob_.fileName = "";
-    currentJob_.PID = 0;
-}
\ No newline at end of file
+    reader.readArray(slots_);
+    reader.readArray(slotStarted_);
+    hardwareQueues_.assign(reader.read<std::uint64_t>(), DiskQueue{});
+    if (slots_.empty() || slots_.size() != slotStarted_.size() || hardwareQueues_.empty())
+        throw std::runtime_error("The checkpoint has a corrupt disk");
+    for (DiskQueue& hardwareQueue : hardwareQueues_)
+    {
+        std::vector<DiskRequest> requests;
+        reader.readArray(requests);
+        for (const DiskRequest& request : requests)
+            hardwareQueue.push(request);
+    }
+    nextQueue_ = reader.read<unsigned int>() % hardwareQueues_.size();
+
+    head_ = reader.read<DiskHead>();
+    requestsServed_ = reader.read<unsigned long long>();
+
+    serviceModel_ = reader.read<DiskServiceModel>();
+    clock_ = reader.read<unsigned long long>();
+    busyTime_ = reader.read<unsigned long long>();
+    requestsCancelled_ = reader.read<unsigned long long>();
+    timeReclaimed_ = reader.read<unsigned long long>();
+    queueDepth_.readCheckpoint(reader);
+    waitTime_.readCheckpoint(reader);
+    serviceTime_.readCheckpoint(reader);
+    responseTime_.readCheckpoint(reader);
+}
@@ -4,13 +4,185 @@
 #include "Process.h"
 #include <iostream>
 #include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "Histogram.h"
+#include "Checkpoint.h"
 
+constexpr unsigned long long DEFAULT_DISK_CYLINDERS{1024};  //Number of cylinders on a disk; requests address cylinders 0 to DEFAULT_DISK_CYLINDERS - 1
+
+//A read request as SimOS reports it, with the name of the file
 struct FileReadRequest
 {
     int PID{0};
     std::string fileName{""};
+    unsigned long long cylinder{0};     //Cylinder the file's blocks are on
+    unsigned long long arrivalTime{0};  //Simulated time the request was made
+    unsigned long long blockCount{1};   //Consecutive blocks read, from a file system read; other reads are one block
+};
+
+//One read in a batch for SimOS::SubmitDiskReads(); it is issued by whichever process is running when its turn comes
+struct DiskSubmission
+{
+    int diskNumber{0};
+    int fileNameID{0};
+    unsigned long long cylinder{0};
+};
+
+//One finished job reported by SimOS::CompleteDiskJobs()
+struct DiskCompletion
+{
+    int diskNumber{0};
+    unsigned int slot{0};               //In-flight slot the job was served in
+    int PID{0};
+    int fileNameID{0};
+};
+
+//A read request as a disk keeps it: a plain record that names the file by its ID in a FileNameTable, so it holds no string
+struct DiskRequest
+{
+    int PID{0};
+    int fileNameID{0};                  //0 is the empty name
+    unsigned long long cylinder{0};
+    unsigned long long arrivalTime{0};
+    unsigned long long blockCount{1};
+};
+
+//Time a disk takes to serve one request, in simulated time units. The default model serves requests instantly.
+struct DiskServiceModel
+{
+    unsigned long long seekSettleTime{0};   //Fixed time to start and settle the head on any seek
+    double seekTimePerCylinder{0};          //Time per cylinder the head travels
+    unsigned long long rotationalDelay{0};  //Average wait for the sector to come under the head
+    unsigned long long transferTime{0};     //Time to transfer one block, its size over the transfer rate; a request of several blocks takes it once per block
+    unsigned long long fixedLatency{0};     //SSD-like constant access latency; when set, it replaces seek and rotation
+};
+
+struct DiskReport
+{
+    unsigned long long requestsStarted{0};
+    unsigned long long busyTime{0};     //Sum of the modeled service times
+    double utilization{0};              //Busy time over elapsed simulated time and in-flight slots; at 1 or more the disk is saturated
+    PercentileSummary queueDepth;       //Requests already at the disk, waiting or being served, when a request arrived
+    PercentileSummary waitTime;         //From arrival to the start of service
+    PercentileSummary serviceTime;
+    PercentileSummary responseTime;     //From arrival to the end of service
+    unsigned long long requestsCancelled{0};    //Waiting requests dropped because their process terminated
+    unsigned long long timeReclaimed{0};        //Expected service time of the cancelled requests, which the disk didn't spend on them
+};
+
+//How busy a disk is, for placing a read on the least loaded disk that can serve it
+struct DiskLoad
+{
+    unsigned long long queueDepth{0};               //Requests at the disk, waiting or being served
+    unsigned long long expectedCompletionTime{0};   //Time until a request made now would be done, from the queue depth, the slots and the expected service time
+};
+
+//Position of a disk's read/write head. Disk scheduling policies move it when they sweep past the requests to an edge of the disk.
+struct DiskHead
+{
+    unsigned long long cylinder{0};
+    bool movingUp{true};                //Direction of the sweep, for the elevator policies
+    unsigned long long seekDistance{0}; //Cylinders travelled since the disk was created
+
+    void seek(const unsigned long long& target) { seekDistance += target > cylinder ? target - cylinder : cylinder - target; cylinder = target; }
+};
+
+struct DiskSeekStats
+{
+    unsigned long long requestsServed{0};
+    unsigned long long seekDistance{0};     //Total cylinders travelled by the head
+    double meanSeekDistance{0};             //Cylinders travelled per request served
+    unsigned long long headCylinder{0};
+};
+
+/*
+    Waiting requests of a disk, indexed both by arrival and by cylinder, so every disk scheduling policy finds its next request in O(log n).
+    A request is identified by its key, the pair of its cylinder and its arrival number; keys order requests by cylinder, then by arrival.
+    The keys are also indexed by PID, so the requests of a terminated process are found without scanning the queue.
+*/
+class DiskQueue
+{
+public:
+    using Key = std::pair<unsigned long long, unsigned long long>;
+
+    //Constructors
+    DiskQueue(): byArrival_{}, byCylinder_{}, byProcess_{}, nextArrival_{0} {}
+
+    //Getters
+    bool empty() const { return byArrival_.empty(); }
+    std::size_t size() const { return byArrival_.size(); }
+    Key oldest() const { return keyOf(*byArrival_.begin()); }
+    Key newest() const { return keyOf(*byArrival_.rbegin()); }
+    Key lowest() const { return *byCylinder_.begin(); }
+    Key highest() const { return oldestOn(byCylinder_.rbegin()->first); }
+    bool findAtOrAbove(const unsigned long long& cylinder, Key& key) const;
+    bool findAtOrBelow(const unsigned long long& cylinder, Key& key) const;
+    std::deque<DiskRequest> toDeque() const;
+    bool contains(const int& PID) const { return byProcess_.count(PID) != 0; }
+
+    //Utilities
+    void push(const DiskRequest& request);
+    DiskRequest take(const Key& key);
+    void clear() { byArrival_.clear(); byCylinder_.clear(); byProcess_.clear(); }
+    std::size_t removeProcess(const int& PID);
+private:
+    static Key keyOf(const std::pair<const unsigned long long, DiskRequest>& entry) { return Key{entry.second.cylinder, entry.first}; }
+    Key oldestOn(const unsigned long long& cylinder) const { return *byCylinder_.lower_bound(Key{cylinder, 0}); }
+
+    std::map<unsigned long long, DiskRequest> byArrival_;
+    std::set<Key> byCylinder_;
+    std::unordered_multimap<int, Key> byProcess_;
+    unsigned long long nextArrival_;
+};
+
+//Disk scheduling policies. A policy picks which waiting request is served next, given the position of the head, and moves the head past the requests if it sweeps to an edge of the disk.
+//The disk then seeks from wherever the policy left the head to the chosen request.
+struct FCFSDiskScheduling
+{
+    //First come, first served: requests are served in arrival order
+    DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead&) const { return diskQueue.oldest(); }
+};
+
+struct LIFODiskScheduling
+{
+    //Last in, first out: the most recent request is served first, which favors locality at the cost of fairness
+    DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead&) const { return diskQueue.newest(); }
+};
+
+struct SSTFDiskScheduling
+{
+    //Shortest seek time first: the request closest to the head is served first, the oldest one on ties. Short seeks, but far requests can starve.
+    DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead& head) const;
+};
+
+struct SCANDiskScheduling
+{
+    //Elevator: the head sweeps to the edge of the disk serving requests on its way, then reverses
+    DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead& head) const;
 };
 
+struct CSCANDiskScheduling
+{
+    //Circular SCAN: the head sweeps up to the last cylinder, returns to cylinder 0 and sweeps up again, so waits are more uniform than with SCAN
+    DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead& head) const;
+};
+
+struct CLOOKDiskScheduling
+{
+    //Circular LOOK: like C-SCAN, but the head only goes as far as the last request and jumps straight back to the lowest one
+    DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead& head) const;
+};
+
+/*
+    A disk with one or more hardware queues and in-flight slots, like an NVMe device. A request that finds a free slot starts at once;
+    otherwise it waits in the hardware queue of its process. A slot that finishes takes the next request from the hardware queues in turn,
+    so jobs run in parallel and can complete out of order. With one queue and one slot, the default, the disk serves one request at a time.
+*/
 class DiskManager
 {
 public:
@@ -18,19 +190,114 @@ public:
     DiskManager();
 
     //Setters
-    void setDiskQueue(const std::deque<FileReadRequest>& diskQueue);
-    void setCurrentFileReadRequest(const FileReadRequest& fileReadRequest);
+    void setDiskQueue(const std::deque<DiskRequest>& diskQueue);
+    void setCurrentDiskRequest(const DiskRequest& request);
+    void setServiceModel(const DiskServiceModel& serviceModel);
+    void setParallelism(const unsigned int& hardwareQueues, const unsigned int& slots);
 
     //Getters
-    std::deque<FileReadRequest> getDiskQueue() const;
-    FileReadRequest getCurrentFileReadRequest() const;
+    std::deque<DiskRequest> getDiskQueue() const;
+    DiskRequest getCurrentDiskRequest() const;
+    DiskRequest getDiskRequest(const unsigned int& slot) const;
+    unsigned int getOldestSlot() const;
+    unsigned int getSlotCount() const;
+    unsigned int getHardwareQueueCount() const;
+    bool isIdle() const;
+    DiskHead getHead() const;
+    DiskSeekStats getSeekStats() const;
+    DiskServiceModel getServiceModel() const;
+    DiskReport getReport(const unsigned long long& currentTime) const;
+    unsigned long long getQueueDepth() const;
+    unsigned long long getMeanServiceTime() const;
+    DiskLoad getLoad() const;
+    const Histogram& getResponseTimeHistogram() const;
 
     //Utilities
-    void addToQueue(const FileReadRequest& job);
+    void addToQueue(const DiskRequest& job);
     void serveNextProcess();
-    void clearCurrentJob();
+    template <class DiskPolicy>
+    void serveNextProcess(const DiskPolicy& diskPolicy);
+    template <class DiskPolicy>
+    void serveNextProcess(const DiskPolicy& diskPolicy, const unsigned long long& currentTime);
+    template <class DiskPolicy>
+    void serveNextProcess(const DiskPolicy& diskPolicy, const unsigned int& slot, const unsigned long long& currentTime);
+    void clearSlot(const unsigned int& slot);
+    bool hasWaitingRequests(const int& PID) const;
+    void cancelRequests(const int& PID);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
 private:
-    FileReadRequest currentJob_;
-    std::deque<FileReadRequest> diskQueue_;
+    void startJob(const unsigned int& slot, const DiskRequest& job, const unsigned long long& startTime, const unsigned long long& seekDistanceBefore);
+    unsigned long long serviceTime(const unsigned long long& seekDistance, const unsigned long long& blockCount) const;
+    std::size_t waitingRequests() const;
+    unsigned long long expectedServiceTime() const;
+
+    std::vector<DiskRequest> slots_;                //Request in flight in each slot, the default DiskRequest if the slot is free
+    std::vector<unsigned long long> slotStarted_;   //Number of the request in each slot among all requests started, to find the oldest one
+    std::vector<DiskQueue> hardwareQueues_;
+    unsigned int nextQueue_;                        //Hardware queue the next free slot takes a request from first
+    DiskHead head_;
+    unsigned long long requestsServed_;
+
+    DiskServiceModel serviceModel_;
+    unsigned long long clock_;      //Latest simulated time the disk was told about
+    unsigned long long busyTime_;
+    unsigned long long requestsCancelled_;
+    unsigned long long timeReclaimed_;
+    Histogram queueDepth_;
+    Histogram waitTime_;
+    Histogram serviceTime_;
+    Histogram responseTime_;
 };
+
+/*
+    @param  A const lvalue reference to the disk scheduling policy.
+    @post   Same as serveNextProcess(diskPolicy, currentTime) at the latest time the disk was told about.
+*/
+template <class DiskPolicy>
+void DiskManager::serveNextProcess(const DiskPolicy& diskPolicy)
+{
+    serveNextProcess(diskPolicy, clock_);
+}
+
+/*
+    @param  A const lvalue reference to the disk scheduling policy.
+    @param  A const lvalue reference to the current simulated time.
+    @post   Same as serveNextProcess(diskPolicy, slot, currentTime) for the slot whose request has been in flight the longest.
+*/
+template <class DiskPolicy>
+void DiskManager::serveNextProcess(const DiskPolicy& diskPolicy, const unsigned long long& currentTime)
+{
+    serveNextProcess(diskPolicy, getOldestSlot(), currentTime);
+}
+
+/*
+    @param  A const lvalue reference to the disk scheduling policy.
+    @param  A const lvalue reference to the number of an existing slot.
+    @param  A const lvalue reference to the current simulated time.
+    @post   The request in the slot is finished. The next hardware queue in turn that has waiting requests gives the slot the request chosen by the policy,
+            and the head seeks to its cylinder; if no request is waiting, the slot is left free.
+            The wait and the modeled service time of the request are recorded.
+            The policy is a template parameter so its choice is inlined.
+*/
+template <class DiskPolicy>
+void DiskManager::serveNextProcess(const DiskPolicy& diskPolicy, const unsigned int& slot, const unsigned long long& currentTime)
+{
+    clock_ = std::max(clock_, currentTime);
+    clearSlot(slot);
+    for (unsigned int i = 0; i < hardwareQueues_.size(); i++)
+    {
+        DiskQueue& hardwareQueue = hardwareQueues_[(nextQueue_ + i) % hardwareQueues_.size()];
+        if (!hardwareQueue.empty())
+        {
+            nextQueue_ = (nextQueue_ + i + 1) % hardwareQueues_.size();
+            unsigned long long seekDistanceBefore = head_.seekDistance;
+            startJob(slot, hardwareQueue.take(diskPolicy.selectNext(hardwareQueue, head_)), clock_, seekDistanceBefore);
+            return;
+        }
+    }
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+// Alan Tuecci
+#ifndef DYNAMICPOLICIES_H
+#define DYNAMICPOLICIES_H
+#include <memory>
+#include <deque>
+#include "CPUManager.h"
+#include "MemoryManager.h"
+#include "DiskManager.h"
+
+/*
+    Type-erased policies, chosen at run time.
+    Each one holds any policy of its kind behind a virtual call, so one PolicySimOS<DynamicScheduling, DynamicReplacement, DynamicDiskScheduling>
+    can run every combination of policies at the price of an indirect call on every timer interrupt, memory access and disk job.
+    Default construction picks the policies SimOS uses.
+*/
+class DynamicScheduling
+{
+public:
+    DynamicScheduling(): DynamicScheduling(RoundRobinScheduling()) {}
+    template <class Scheduler>
+    explicit DynamicScheduling(const Scheduler& scheduler): policy_{std::make_shared<Model<Scheduler>>(scheduler)} {}
+
+    bool preemptsOnTimer() const { return policy_->preemptsOnTimer(); }
+private:
+    struct Concept
+    {
+        virtual ~Concept() = default;
+        virtual bool preemptsOnTimer() const = 0;
+    };
+    template <class Scheduler>
+    struct Model : Concept
+    {
+        explicit Model(const Scheduler& scheduler): policy{scheduler} {}
+        bool preemptsOnTimer() const override { return policy.preemptsOnTimer(); }
+        Scheduler policy;
+    };
+
+    std::shared_ptr<const Concept> policy_;
+};
+
+class DynamicReplacement
+{
+public:
+    DynamicReplacement(): DynamicReplacement(LRUReplacement()) {}
+    template <class Replacement>
+    explicit DynamicReplacement(const Replacement& replacement): policy_{std::make_shared<Model<Replacement>>(replacement)} {}
+
+    bool refreshesOnHit() const { return policy_->refreshesOnHit(); }
+private:
+    struct Concept
+    {
+        virtual ~Concept() = default;
+        virtual bool refreshesOnHit() const = 0;
+    };
+    template <class Replacement>
+    struct Model : Concept
+    {
+        explicit Model(const Replacement& replacement): policy{replacement} {}
+        bool refreshesOnHit() const override { return policy.refreshesOnHit(); }
+        Replacement policy;
+    };
+
+    std::shared_ptr<const Concept> policy_;
+};
+
+class DynamicDiskScheduling
+{
+public:
+    DynamicDiskScheduling(): DynamicDiskScheduling(FCFSDiskScheduling()) {}
+    template <class DiskPolicy>
+    explicit DynamicDiskScheduling(const DiskPolicy& diskPolicy): policy_{std::make_shared<Model<DiskPolicy>>(diskPolicy)} {}
+
+    DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead& head) const { return policy_->selectNext(diskQueue, head); }
+private:
+    struct Concept
+    {
+        virtual ~Concept() = default;
+        virtual DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead& head) const = 0;
+    };
+    template <class DiskPolicy>
+    struct Model : Concept
+    {
+        explicit Model(const DiskPolicy& diskPolicy): policy{diskPolicy} {}
+        DiskQueue::Key selectNext(const DiskQueue& diskQueue, DiskHead& head) const override { return policy.selectNext(diskQueue, head); }
+        DiskPolicy policy;
+    };
+
+    std::shared_ptr<const Concept> policy_;
+};
+#endif
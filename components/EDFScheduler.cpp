@@ -0,0 +1,415 @@
+// Alan Tuecci
+#include "EDFScheduler.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   No real-time processes are admitted and both heaps are empty.
+*/
+EDFScheduler::EDFScheduler():
+    tasks_{},
+    readyHeap_{},
+    releaseHeap_{},
+    readyJobs_{0},
+    utilization_{0},
+    report_{}
+{
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @return True if no real-time process is admitted.
+*/
+bool EDFScheduler::isEmpty() const
+{
+    return tasks_.empty();
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @return True if the process was admitted to the real-time class and has not terminated.
+*/
+bool EDFScheduler::isRealTime(const int& processID) const
+{
+    return tasks_.find(processID) != tasks_.end();
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @return True if the process is a real-time process whose current job is done and whose next job is not yet released.
+*/
+bool EDFScheduler::isSleeping(const int& processID) const
+{
+    std::unordered_map<int, Task>::const_iterator task = tasks_.find(processID);
+    return task != tasks_.end() && !task->second.jobActive;
+}
+
+/*
+    @return True if at least one released job is waiting for the CPU.
+*/
+bool EDFScheduler::hasReadyJob() const
+{
+    return readyJobs_ > 0;
+}
+
+/*
+    @return The absolute deadline of the most urgent waiting job.
+            The largest representable time if no job is waiting.
+*/
+unsigned long long EDFScheduler::getEarliestDeadline() const
+{
+    if (readyHeap_.empty())
+        return static_cast<unsigned long long>(-1);
+    return readyHeap_.front().first;
+}
+
+/*
+    @param  A const lvalue reference to a real-time process ID.
+    @return The absolute deadline of the current job of the process.
+
+    @note   If the process is not a real-time process, throw std::out_of_range exception.
+*/
+unsigned long long EDFScheduler::getDeadline(const int& processID) const
+{
+    return tasks_.at(processID).deadline;
+}
+
+/*
+    @return The PIDs of the waiting jobs, earliest deadline first.
+*/
+std::vector<int> EDFScheduler::getReadyQueue() const
+{
+    std::vector<HeapEntry> waiting;
+    for (const HeapEntry& entry : readyHeap_)
+    {
+        std::unordered_map<int, Task>::const_iterator task = tasks_.find(entry.second);
+        if (task != tasks_.end() && task->second.queued && task->second.deadline == entry.first)
+            waiting.push_back(entry);
+    }
+    std::sort(waiting.begin(), waiting.end());
+
+    std::vector<int> readyQueue;
+    for (const HeapEntry& entry : waiting)
+        readyQueue.push_back(entry.second);
+    return readyQueue;
+}
+
+/*
+    @return The processor utilization reserved by the admitted real-time processes.
+*/
+double EDFScheduler::getUtilization() const
+{
+    return utilization_;
+}
+
+/*
+    @return Admission and job counters, the deadline misses and the lateness and slack distributions.
+*/
+RealTimeReport EDFScheduler::getReport() const
+{
+    RealTimeReport report = report_;
+    report.utilization = utilization_;
+    report.lateness = lateness_.getSummary();
+    report.slack = slack_.getSummary();
+    return report;
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the ID of a new process.
+    @param  A const lvalue reference to the period, relative deadline and budget of the process.
+    @param  The current simulated time, at which the first job is released.
+    @post   If the process passes the utilization test, it is admitted with an active first job.
+            The job is not queued; the caller decides whether it runs right away or waits.
+    @return True if the process was admitted, false if admitting it could make a deadline unreachable.
+
+    @note   Admission uses the density test: the sum of budget / min(period, relative deadline) may not exceed 1.
+            It is exact for deadlines no shorter than their periods and sufficient otherwise.
+    @note   If the period, relative deadline or budget is 0, throw std::invalid_argument exception.
+*/
+bool EDFScheduler::admit(const int& processID, const RealTimeParameters& parameters, const unsigned long long& now)
+{
+    if (parameters.period == 0 || parameters.relativeDeadline == 0 || parameters.budget == 0)
+        throw std::invalid_argument("Real-time processes need a non-zero period, deadline and budget");
+
+    double processDensity = density(parameters);
+    if (utilization_ + processDensity > 1.0 + 1e-9)
+    {
+        report_.rejectedProcesses++;
+        return false;
+    }
+
+    Task& task = tasks_[processID];
+    task = Task{};
+    task.parameters = parameters;
+    task.release = now;
+    releaseJob(task);
+
+    utilization_ += processDensity;
+    report_.admittedProcesses++;
+    return true;
+}
+
+/*
+    @param  A const lvalue reference to a real-time process ID.
+    @post   If the process has an active job, the job joins the ready heap.
+    @return True if the process is runnable, false if it is sleeping until its next release.
+*/
+bool EDFScheduler::makeRunnable(const int& processID)
+{
+    std::unordered_map<int, Task>::iterator task = tasks_.find(processID);
+    if (task == tasks_.end() || !task->second.jobActive)
+        return false;
+
+    if (!task->second.queued)
+    {
+        task->second.queued = true;
+        readyHeap_.push_back(HeapEntry(task->second.deadline, processID));
+        std::push_heap(readyHeap_.begin(), readyHeap_.end(), EarliestFirst());
+        readyJobs_++;
+    }
+    return true;
+}
+
+/*
+    @post   The waiting job with the earliest deadline leaves the ready heap.
+    @return The PID of that job, or NO_PROCESS if no job is waiting.
+*/
+int EDFScheduler::popEarliest()
+{
+    pruneReadyHeap();
+    if (readyHeap_.empty())
+        return NO_PROCESS;
+
+    int processID = readyHeap_.front().second;
+    std::pop_heap(readyHeap_.begin(), readyHeap_.end(), EarliestFirst());
+    readyHeap_.pop_back();
+    tasks_[processID].queued = false;
+    readyJobs_--;
+
+    pruneReadyHeap();
+    return processID;
+}
+
+/*
+    @param  A const lvalue reference to the ID of the real-time process that was running.
+    @param  The CPU time the process just used.
+    @param  The current simulated time.
+    @post   The CPU time is taken from the budget of the current job.
+            A job whose budget runs out completes: its lateness or slack is recorded and the process sleeps until its next release.
+            If the next release is already due (the job overran its period) the next job starts right away.
+    @return True if the current job completed, false otherwise.
+*/
+bool EDFScheduler::consumeBudget(const int& processID, const unsigned long long& cpuTime, const unsigned long long& now)
+{
+    std::unordered_map<int, Task>::iterator found = tasks_.find(processID);
+    if (found == tasks_.end() || !found->second.jobActive)
+        return false;
+
+    Task& task = found->second;
+    task.remaining = task.remaining > cpuTime ? task.remaining - cpuTime : 0;
+    if (task.remaining > 0)
+        return false;
+
+    report_.completedJobs++;
+    if (now > task.deadline)
+    {
+        report_.deadlineMisses++;
+        lateness_.record(now - task.deadline);
+    }
+    else
+        slack_.record(task.deadline - now);
+
+    task.jobActive = false;
+    task.release += task.parameters.period;
+    if (task.release <= now)
+        releaseJob(task);
+    else
+    {
+        releaseHeap_.push_back(HeapEntry(task.release, processID));
+        std::push_heap(releaseHeap_.begin(), releaseHeap_.end(), EarliestFirst());
+    }
+    return true;
+}
+
+/*
+    @param  The current simulated time.
+    @post   Every sleeping process whose next release time has passed gets a new job, which joins the ready heap.
+    @return The PIDs of the processes that were woken up.
+*/
+std::vector<int> EDFScheduler::releaseDueJobs(const unsigned long long& now)
+{
+    std::vector<int> released;
+    pruneReleaseHeap();
+    while (!releaseHeap_.empty() && releaseHeap_.front().first <= now)
+    {
+        int processID = releaseHeap_.front().second;
+        std::pop_heap(releaseHeap_.begin(), releaseHeap_.end(), EarliestFirst());
+        releaseHeap_.pop_back();
+
+        releaseJob(tasks_[processID]);
+        makeRunnable(processID);
+        released.push_back(processID);
+        pruneReleaseHeap();
+    }
+    return released;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @post   The process leaves the real-time class and its reserved utilization is freed.
+            Heap entries of the process are skipped from now on.
+*/
+void EDFScheduler::removeProcess(const int& processID)
+{
+    std::unordered_map<int, Task>::iterator task = tasks_.find(processID);
+    if (task == tasks_.end())
+        return;
+
+    if (task->second.queued)
+        readyJobs_--;
+    utilization_ -= density(task->second.parameters);
+    if (utilization_ < 0)
+        utilization_ = 0;
+    tasks_.erase(task);
+
+    pruneReadyHeap();
+    pruneReleaseHeap();
+}
+
+/*
+    @param  A const lvalue reference to real-time parameters.
+    @return The share of the processor a process with those parameters needs in the worst case.
+*/
+double EDFScheduler::density(const RealTimeParameters& parameters)
+{
+    unsigned long long window = std::min(parameters.period, parameters.relativeDeadline);
+    return static_cast<double>(parameters.budget) / window;
+}
+
+/*
+    @param  A reference to the task whose release time is set.
+    @post   A new job starts at the task's release time with a full budget and an absolute deadline relative to its release.
+*/
+void EDFScheduler::releaseJob(Task& task)
+{
+    task.deadline = task.release + task.parameters.relativeDeadline;
+    task.remaining = task.parameters.budget;
+    task.jobActive = true;
+    report_.releasedJobs++;
+}
+
+/*
+    @post   Entries of terminated or no longer queued jobs are popped off the top of the ready heap.
+*/
+void EDFScheduler::pruneReadyHeap()
+{
+    while (!readyHeap_.empty())
+    {
+        std::unordered_map<int, Task>::const_iterator task = tasks_.find(readyHeap_.front().second);
+        if (task != tasks_.end() && task->second.queued && task->second.deadline == readyHeap_.front().first)
+            break;
+        std::pop_heap(readyHeap_.begin(), readyHeap_.end(), EarliestFirst());
+        readyHeap_.pop_back();
+    }
+}
+
+/*
+    @post   Entries of terminated or already released processes are popped off the top of the release heap.
+*/
+void EDFScheduler::pruneReleaseHeap()
+{
+    while (!releaseHeap_.empty())
+    {
+        std::unordered_map<int, Task>::const_iterator task = tasks_.find(releaseHeap_.front().second);
+        if (task != tasks_.end() && !task->second.jobActive && task->second.release == releaseHeap_.front().first)
+            break;
+        std::pop_heap(releaseHeap_.begin(), releaseHeap_.end(), EarliestFirst());
+        releaseHeap_.pop_back();
+    }
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The tasks, both heaps in heap order, the report and the histograms are appended to the checkpoint.
+            Maps and heap entries are written as parallel arrays of keys and values.
+*/
+void EDFScheduler::writeCheckpoint(CheckpointWriter& writer) const
+{
+    std::vector<int> taskIDs;
+    std::vector<Task> tasks;
+    taskIDs.reserve(tasks_.size());
+    tasks.reserve(tasks_.size());
+    for (const std::pair<const int, Task>& task : tasks_)
+    {
+        taskIDs.push_back(task.first);
+        tasks.push_back(task.second);
+    }
+    writer.writeArray(taskIDs);
+    writer.writeArray(tasks);
+
+    for (const std::vector<HeapEntry>* heap : {&readyHeap_, &releaseHeap_})
+    {
+        std::vector<unsigned long long> keys;
+        std::vector<int> processIDs;
+        keys.reserve(heap->size());
+        processIDs.reserve(heap->size());
+        for (const HeapEntry& entry : *heap)
+        {
+            keys.push_back(entry.first);
+            processIDs.push_back(entry.second);
+        }
+        writer.writeArray(keys);
+        writer.writeArray(processIDs);
+    }
+
+    writer.write(readyJobs_);
+    writer.write(utilization_);
+    writer.write(report_);
+    lateness_.writeCheckpoint(writer);
+    slack_.writeCheckpoint(writer);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The scheduler is in the state it was in when the checkpoint was written.
+
+    @note   If the arrays of a map or a heap have different lengths, throw std::runtime_error exception.
+*/
+void EDFScheduler::readCheckpoint(CheckpointReader& reader)
+{
+    std::vector<int> taskIDs;
+    std::vector<Task> tasks;
+    reader.readArray(taskIDs);
+    reader.readArray(tasks);
+    if (taskIDs.size() != tasks.size())
+        throw std::runtime_error("The checkpoint has a corrupt real-time task table");
+    tasks_.clear();
+    tasks_.reserve(tasks.size());
+    for (unsigned int i = 0; i < tasks.size(); i++)
+        tasks_.emplace(taskIDs[i], tasks[i]);
+
+    for (std::vector<HeapEntry>* heap : {&readyHeap_, &releaseHeap_})
+    {
+        std::vector<unsigned long long> keys;
+        std::vector<int> processIDs;
+        reader.readArray(keys);
+        reader.readArray(processIDs);
+        if (keys.size() != processIDs.size())
+            throw std::runtime_error("The checkpoint has a corrupt real-time heap");
+        heap->clear();
+        heap->reserve(keys.size());
+        for (unsigned int i = 0; i < keys.size(); i++)
+            heap->emplace_back(keys[i], processIDs[i]);
+    }
+
+    readyJobs_ = reader.read<unsigned long long>();
+    utilization_ = reader.read<double>();
+    report_ = reader.read<RealTimeReport>();
+    lateness_.readCheckpoint(reader);
+    slack_.readCheckpoint(reader);
+}
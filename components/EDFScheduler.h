@@ -0,0 +1,93 @@
+// Alan Tuecci
+#ifndef EDFSCHEDULER_H
+#define EDFSCHEDULER_H
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "Process.h"
+#include "Histogram.h"
+#include "Checkpoint.h"
+
+struct RealTimeParameters
+{
+    unsigned long long period{0};           //Time between job releases
+    unsigned long long relativeDeadline{0}; //Time after its release by which a job must finish
+    unsigned long long budget{0};           //CPU time each job needs
+};
+
+struct RealTimeReport
+{
+    unsigned long long admittedProcesses{0};
+    unsigned long long rejectedProcesses{0};    //Processes refused by the utilization test
+    unsigned long long releasedJobs{0};
+    unsigned long long completedJobs{0};
+    unsigned long long deadlineMisses{0};
+    double utilization{0};                      //Sum of budget / min(period, deadline) over admitted live processes
+    PercentileSummary lateness;                 //How late the jobs that missed their deadline finished
+    PercentileSummary slack;                    //How early the jobs that met their deadline finished
+};
+
+/*
+    Earliest-deadline-first scheduling class for periodic real-time processes.
+    Ready jobs are kept in a min-heap on absolute deadline and sleeping processes in a min-heap on their next release time.
+    Entries of terminated processes are left in the heaps and skipped when they reach the top.
+*/
+class EDFScheduler
+{
+public:
+    //Constructors
+    EDFScheduler();
+
+    //Getters
+    bool isEmpty() const;
+    bool isRealTime(const int& processID) const;
+    bool isSleeping(const int& processID) const;
+    bool hasReadyJob() const;
+    unsigned long long getEarliestDeadline() const;
+    unsigned long long getDeadline(const int& processID) const;
+    std::vector<int> getReadyQueue() const;
+    double getUtilization() const;
+    RealTimeReport getReport() const;
+
+    //Utilities
+    bool admit(const int& processID, const RealTimeParameters& parameters, const unsigned long long& now);
+    bool makeRunnable(const int& processID);
+    int popEarliest();
+    bool consumeBudget(const int& processID, const unsigned long long& cpuTime, const unsigned long long& now);
+    std::vector<int> releaseDueJobs(const unsigned long long& now);
+    void removeProcess(const int& processID);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    struct Task
+    {
+        RealTimeParameters parameters;
+        unsigned long long release{0};      //Release time of the current job, or of the next job while sleeping
+        unsigned long long deadline{0};     //Absolute deadline of the current job
+        unsigned long long remaining{0};    //CPU time the current job still needs
+        bool jobActive{false};
+        bool queued{false};
+    };
+    using HeapEntry = std::pair<unsigned long long, int>;
+    using EarliestFirst = std::greater<HeapEntry>;
+
+    static double density(const RealTimeParameters& parameters);
+    void releaseJob(Task& task);
+    void pruneReadyHeap();
+    void pruneReleaseHeap();
+
+    std::unordered_map<int, Task> tasks_;
+    std::vector<HeapEntry> readyHeap_;      //(absolute deadline, PID) of queued jobs
+    std::vector<HeapEntry> releaseHeap_;    //(next release time, PID) of sleeping processes
+    unsigned long long readyJobs_;
+    double utilization_;
+
+    RealTimeReport report_;
+    Histogram lateness_;
+    Histogram slack_;
+};
+#endif
@@ -0,0 +1,96 @@
+// Alan Tuecci
+#include "FileNameTable.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   The table holds only the empty name, with ID 0.
+*/
+FileNameTable::FileNameTable() : names_{""}, fileNameIDs_{{"", 0}}
+{
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the ID of a name.
+    @return A const reference to the name, valid until the table is changed.
+
+    @note   If no name has the ID, throw std::out_of_range exception.
+*/
+const std::string& FileNameTable::getName(const int& fileNameID) const
+{
+    if (fileNameID < 0 || static_cast<std::size_t>(fileNameID) >= names_.size())
+        throw std::out_of_range("There is no file name with this ID");
+    return names_[fileNameID];
+}
+
+/*
+    @param  A const lvalue reference to a file name.
+    @return The ID of the name, or -1 if it isn't in the table. Unlike intern(), this never changes the table.
+*/
+int FileNameTable::find(const std::string& fileName) const
+{
+    std::unordered_map<std::string, int>::const_iterator fileNameID = fileNameIDs_.find(fileName);
+    return fileNameID != fileNameIDs_.end() ? fileNameID->second : -1;
+}
+
+/*
+    @return The number of distinct names, including the empty name.
+*/
+std::size_t FileNameTable::size() const
+{
+    return names_.size();
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  A const lvalue reference to a file name.
+    @post   The name is added to the table if it isn't in it yet.
+    @return The ID of the name. The same name always gets the same ID.
+*/
+int FileNameTable::intern(const std::string& fileName)
+{
+    int fileNameID = find(fileName);
+    if (fileNameID != -1)
+        return fileNameID;
+    int newID = static_cast<int>(names_.size());
+    names_.push_back(fileName);
+    fileNameIDs_.emplace(fileName, newID);
+    return newID;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The names are appended to the checkpoint in ID order.
+*/
+void FileNameTable::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(static_cast<std::uint64_t>(names_.size()));
+    for (const std::string& name : names_)
+        writer.writeString(name);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The table holds the names it held when the checkpoint was written, under the same IDs.
+
+    @note   If the names aren't distinct or don't start with the empty name, throw std::runtime_error exception.
+*/
+void FileNameTable::readCheckpoint(CheckpointReader& reader)
+{
+    std::uint64_t count = reader.read<std::uint64_t>();
+    names_.clear();
+    fileNameIDs_.clear();
+    for (std::uint64_t i = 0; i < count; i++)
+    {
+        names_.push_back(reader.readString());
+        if (!fileNameIDs_.emplace(names_.back(), static_cast<int>(i)).second)
+            throw std::runtime_error("The checkpoint has a corrupt file name table");
+    }
+    if (names_.empty() || !names_[0].empty())
+        throw std::runtime_error("The checkpoint has a corrupt file name table");
+}
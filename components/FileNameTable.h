@@ -0,0 +1,35 @@
+// Alan Tuecci
+#ifndef FILENAMETABLE_H
+#define FILENAMETABLE_H
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include "Checkpoint.h"
+
+/*
+    Intern table of file names. Each distinct name is stored once and gets a small integer ID, so requests can carry the ID instead of a string.
+    ID 0 is always the empty name.
+*/
+class FileNameTable
+{
+public:
+    //Constructors
+    FileNameTable();
+
+    //Getters
+    const std::string& getName(const int& fileNameID) const;
+    int find(const std::string& fileName) const;
+    std::size_t size() const;
+
+    //Utilities
+    int intern(const std::string& fileName);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    std::vector<std::string> names_;                //Indexed by ID
+    std::unordered_map<std::string, int> fileNameIDs_;
+};
+#endif
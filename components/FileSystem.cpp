@@ -0,0 +1,309 @@
+// Alan Tuecci
+#include "FileSystem.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   An empty file system whose free space is the whole disk.
+*/
+FileSystem::FileSystem() :
+    freeExtents_{},
+    freeBlocks_{DEFAULT_DISK_BLOCKS},
+    files_{},
+    pending_{},
+    reads_{0},
+    blocksRead_{0},
+    extentRequests_{0}
+{
+    freeExtents_[0] = DEFAULT_DISK_BLOCKS;
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the ID of a file name.
+    @return True if the file is on the disk.
+*/
+bool FileSystem::contains(const int& fileNameID) const
+{
+    return files_.count(fileNameID) != 0;
+}
+
+/*
+    @param  A const lvalue reference to the ID of the name of a file on the disk.
+    @return The extents of the file, in file order.
+*/
+std::vector<Extent> FileSystem::getExtents(const int& fileNameID) const
+{
+    return files_.at(fileNameID);
+}
+
+/*
+    @param  A const lvalue reference to the ID of the name of a file on the disk.
+    @return The size of the file in blocks.
+*/
+unsigned long long FileSystem::getFileSize(const int& fileNameID) const
+{
+    unsigned long long size{0};
+    for (const Extent& extent : files_.at(fileNameID))
+        size += extent.blockCount;
+    return size;
+}
+
+/*
+    @return The number of free blocks.
+*/
+unsigned long long FileSystem::getFreeBlocks() const
+{
+    return freeBlocks_;
+}
+
+/*
+    @param  A const lvalue reference to a PID.
+    @return True if the process is waiting for requests of a read of this file system.
+*/
+bool FileSystem::isPending(const int& PID) const
+{
+    return !pending_.empty() && pending_.count(PID) != 0;
+}
+
+/*
+    @return The space and files of the file system, how fragmented the files and the free space are, and the reads made.
+*/
+FileSystemStats FileSystem::getStats() const
+{
+    FileSystemStats stats;
+    stats.totalBlocks = DEFAULT_DISK_BLOCKS;
+    stats.freeBlocks = freeBlocks_;
+    stats.files = files_.size();
+    for (const std::pair<const int, std::vector<Extent>>& file : files_)
+        stats.fileExtents += file.second.size();
+    if (!files_.empty())
+        stats.meanExtentsPerFile = static_cast<double>(stats.fileExtents) / files_.size();
+    stats.freeExtents = freeExtents_.size();
+    for (const std::pair<const unsigned long long, unsigned long long>& extent : freeExtents_)
+        stats.largestFreeExtent = std::max(stats.largestFreeExtent, extent.second);
+    if (freeBlocks_ != 0)
+        stats.externalFragmentation = 1 - static_cast<double>(stats.largestFreeExtent) / freeBlocks_;
+    stats.reads = reads_;
+    stats.blocksRead = blocksRead_;
+    stats.extentRequests = extentRequests_;
+    return stats;
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the ID of the name of a file that isn't on the disk.
+    @param  A const lvalue reference to the size of the file in blocks, at least 1 and at most the free blocks.
+    @post   The file takes the first free extent that fits it whole. If no extent does, it takes free extents in address order until it has its size.
+*/
+void FileSystem::createFile(const int& fileNameID, const unsigned long long& sizeInBlocks)
+{
+    std::vector<Extent>& extents = files_[fileNameID];
+    std::map<unsigned long long, unsigned long long>::iterator fit = freeExtents_.begin();
+    while (fit != freeExtents_.end() && fit->second < sizeInBlocks)
+        fit++;
+
+    unsigned long long needed = sizeInBlocks;
+    std::map<unsigned long long, unsigned long long>::iterator next = fit != freeExtents_.end() ? fit : freeExtents_.begin();
+    while (needed != 0)
+    {
+        Extent taken{next->first, std::min(next->second, needed)};
+        unsigned long long remaining = next->second - taken.blockCount;
+        next = freeExtents_.erase(next);
+        if (remaining != 0)
+            next = freeExtents_.emplace_hint(next, taken.firstBlock + taken.blockCount, remaining);
+        extents.push_back(taken);
+        needed -= taken.blockCount;
+    }
+    freeBlocks_ -= sizeInBlocks;
+}
+
+/*
+    @param  A const lvalue reference to the ID of the name of a file on the disk.
+    @post   The file's extents become free and merge with the free extents next to them.
+*/
+void FileSystem::deleteFile(const int& fileNameID)
+{
+    std::unordered_map<int, std::vector<Extent>>::iterator file = files_.find(fileNameID);
+    for (const Extent& extent : file->second)
+        release(extent);
+    files_.erase(file);
+}
+
+/*
+    @param  A const lvalue reference to the ID of the name of a file on the disk.
+    @param  A const lvalue reference to the first block of the file to read.
+    @param  A const lvalue reference to the number of blocks, so that the range ends within the file.
+    @return The runs of disk blocks the range covers, one per extent it touches, in file order.
+*/
+std::vector<Extent> FileSystem::mapRead(const int& fileNameID, const unsigned long long& firstBlock, const unsigned long long& blockCount) const
+{
+    std::vector<Extent> ranges;
+    unsigned long long skip = firstBlock;
+    unsigned long long needed = blockCount;
+    for (const Extent& extent : files_.at(fileNameID))
+    {
+        if (needed == 0)
+            break;
+        else if (skip >= extent.blockCount)
+        {
+            skip -= extent.blockCount;
+            continue;
+        }
+        Extent range{extent.firstBlock + skip, std::min(extent.blockCount - skip, needed)};
+        ranges.push_back(range);
+        needed -= range.blockCount;
+        skip = 0;
+    }
+    return ranges;
+}
+
+/*
+    @param  A const lvalue reference to the PID of the reading process.
+    @param  A const lvalue reference to the number of blocks read.
+    @param  A const lvalue reference to the number of requests the read was split into, at least 1.
+    @post   The process waits until that many requests complete.
+*/
+void FileSystem::startRead(const int& PID, const unsigned long long& blockCount, const std::size_t& requests)
+{
+    pending_[PID] = requests;
+    reads_++;
+    blocksRead_ += blockCount;
+    extentRequests_ += requests;
+}
+
+/*
+    @param  A const lvalue reference to the PID of a process with a pending read.
+    @post   One request of the read is completed.
+    @return True if it was the last one and the process can be woken.
+*/
+bool FileSystem::finishRequest(const int& PID)
+{
+    std::unordered_map<int, unsigned long long>::iterator read = pending_.find(PID);
+    if (--read->second != 0)
+        return false;
+    pending_.erase(read);
+    return true;
+}
+
+/*
+    @param  A const lvalue reference to an extent of a deleted file.
+    @post   The extent is free, merged with the free extents right before and after it.
+*/
+void FileSystem::release(const Extent& extent)
+{
+    unsigned long long first = extent.firstBlock;
+    unsigned long long length = extent.blockCount;
+    std::map<unsigned long long, unsigned long long>::iterator after = freeExtents_.lower_bound(first);
+    if (after != freeExtents_.begin())
+    {
+        std::map<unsigned long long, unsigned long long>::iterator before = std::prev(after);
+        if (before->first + before->second == first)
+        {
+            first = before->first;
+            length += before->second;
+            freeExtents_.erase(before);
+        }
+    }
+    if (after != freeExtents_.end() && extent.firstBlock + extent.blockCount == after->first)
+    {
+        length += after->second;
+        after = freeExtents_.erase(after);
+    }
+    freeExtents_.emplace_hint(after, first, length);
+    freeBlocks_ += extent.blockCount;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The free extents, the extent map of every file, the pending reads and the counters are appended to the checkpoint.
+*/
+void FileSystem::writeCheckpoint(CheckpointWriter& writer) const
+{
+    std::vector<Extent> freeExtents;
+    for (const std::pair<const unsigned long long, unsigned long long>& extent : freeExtents_)
+        freeExtents.push_back(Extent{extent.first, extent.second});
+    writer.writeArray(freeExtents);
+
+    std::vector<int> fileNameIDs;
+    std::vector<unsigned long long> extentCounts;
+    std::vector<Extent> extents;
+    for (const std::pair<const int, std::vector<Extent>>& file : files_)
+    {
+        fileNameIDs.push_back(file.first);
+        extentCounts.push_back(file.second.size());
+        extents.insert(extents.end(), file.second.begin(), file.second.end());
+    }
+    writer.writeArray(fileNameIDs);
+    writer.writeArray(extentCounts);
+    writer.writeArray(extents);
+
+    std::vector<int> readers;
+    std::vector<unsigned long long> requests;
+    for (const std::pair<const int, unsigned long long>& read : pending_)
+    {
+        readers.push_back(read.first);
+        requests.push_back(read.second);
+    }
+    writer.writeArray(readers);
+    writer.writeArray(requests);
+
+    writer.write(reads_);
+    writer.write(blocksRead_);
+    writer.write(extentRequests_);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The file system is in the state it was in when the checkpoint was written.
+
+    @note   If the files, their extents or the pending reads don't add up, throw std::runtime_error exception.
+*/
+void FileSystem::readCheckpoint(CheckpointReader& reader)
+{
+    std::vector<Extent> freeExtents;
+    reader.readArray(freeExtents);
+    freeExtents_.clear();
+    freeBlocks_ = 0;
+    for (const Extent& extent : freeExtents)
+    {
+        freeExtents_.emplace_hint(freeExtents_.end(), extent.firstBlock, extent.blockCount);
+        freeBlocks_ += extent.blockCount;
+    }
+
+    std::vector<int> fileNameIDs;
+    std::vector<unsigned long long> extentCounts;
+    std::vector<Extent> extents;
+    reader.readArray(fileNameIDs);
+    reader.readArray(extentCounts);
+    reader.readArray(extents);
+    if (fileNameIDs.size() != extentCounts.size())
+        throw std::runtime_error("The checkpoint has a corrupt file system");
+    files_.clear();
+    std::size_t next{0};
+    for (std::size_t i = 0; i < fileNameIDs.size(); i++)
+    {
+        if (extentCounts[i] > extents.size() - next)
+            throw std::runtime_error("The checkpoint has a corrupt file system");
+        files_[fileNameIDs[i]].assign(extents.begin() + next, extents.begin() + next + extentCounts[i]);
+        next += extentCounts[i];
+    }
+
+    std::vector<int> readers;
+    std::vector<unsigned long long> requests;
+    reader.readArray(readers);
+    reader.readArray(requests);
+    if (readers.size() != requests.size())
+        throw std::runtime_error("The checkpoint has a corrupt file system");
+    pending_.clear();
+    for (std::size_t i = 0; i < readers.size(); i++)
+        pending_[readers[i]] = requests[i];
+
+    reads_ = reader.read<unsigned long long>();
+    blocksRead_ = reader.read<unsigned long long>();
+    extentRequests_ = reader.read<unsigned long long>();
+}
@@ -0,0 +1,95 @@
+// Alan Tuecci
+#ifndef FILESYSTEM_H
+#define FILESYSTEM_H
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <iterator>
+#include "DiskManager.h"
+#include "Checkpoint.h"
+
+constexpr unsigned long long DEFAULT_BLOCKS_PER_CYLINDER{64};  //Blocks on each cylinder; block b is on cylinder b / DEFAULT_BLOCKS_PER_CYLINDER
+constexpr unsigned long long DEFAULT_DISK_BLOCKS{DEFAULT_DISK_CYLINDERS * DEFAULT_BLOCKS_PER_CYLINDER};
+
+//A run of consecutive blocks on a disk
+struct Extent
+{
+    unsigned long long firstBlock{0};
+    unsigned long long blockCount{0};
+};
+
+struct FileSystemStats
+{
+    unsigned long long totalBlocks{0};
+    unsigned long long freeBlocks{0};
+    unsigned long long files{0};
+    unsigned long long fileExtents{0};          //Extents of all files; a file in one piece has one
+    double meanExtentsPerFile{0};
+    unsigned long long freeExtents{0};          //Runs of free blocks
+    unsigned long long largestFreeExtent{0};
+    double externalFragmentation{0};            //1 minus the largest free extent over the free blocks; 0 when the free space is one run
+    unsigned long long reads{0};
+    unsigned long long blocksRead{0};
+    unsigned long long extentRequests{0};       //Disk requests the reads were split into, one per extent they touched
+};
+
+/*
+    File system of one disk. Files have a size in blocks and an extent map, and free space is a map of free extents kept coalesced.
+    A new file takes the first free extent that fits it; if none does, it is split over free extents in address order, so an aged disk fragments files.
+    A read of a range of a file becomes one request per extent it touches, and the reading process is woken when the last one completes.
+*/
+class FileSystem
+{
+public:
+    //Constructors
+    FileSystem();
+
+    //Getters
+    bool contains(const int& fileNameID) const;
+    std::vector<Extent> getExtents(const int& fileNameID) const;
+    unsigned long long getFileSize(const int& fileNameID) const;
+    unsigned long long getFreeBlocks() const;
+    bool isPending(const int& PID) const;
+    FileSystemStats getStats() const;
+
+    //Utilities
+    void createFile(const int& fileNameID, const unsigned long long& sizeInBlocks);
+    void deleteFile(const int& fileNameID);
+    std::vector<Extent> mapRead(const int& fileNameID, const unsigned long long& firstBlock, const unsigned long long& blockCount) const;
+    void startRead(const int& PID, const unsigned long long& blockCount, const std::size_t& requests);
+    bool finishRequest(const int& PID);
+    template <class Predicate>
+    void removeProcesses(const Predicate& shouldRemove);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    void release(const Extent& extent);
+
+    std::map<unsigned long long, unsigned long long> freeExtents_;  //First block of each free extent, to its length
+    unsigned long long freeBlocks_;
+    std::unordered_map<int, std::vector<Extent>> files_;            //Extent map of each file, by file name ID, in file order
+    std::unordered_map<int, unsigned long long> pending_;           //Requests each reading process waits for
+
+    unsigned long long reads_;
+    unsigned long long blocksRead_;
+    unsigned long long extentRequests_;
+};
+
+/*
+    @param  A const lvalue reference to a function that takes a PID and returns true if the process is gone.
+    @post   The pending reads of such processes are dropped. Their requests still complete, but wake no one.
+*/
+template <class Predicate>
+void FileSystem::removeProcesses(const Predicate& shouldRemove)
+{
+    for (std::unordered_map<int, unsigned long long>::iterator i = pending_.begin(); i != pending_.end(); )
+    {
+        if (shouldRemove(i->first))
+            i = pending_.erase(i);
+        else
+            i++;
+    }
+}
+#endif
@@ -0,0 +1,230 @@
+// Alan Tuecci
+#include "Histogram.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   Histogram is initialized with every bucket empty.
+*/
+Histogram::Histogram():
+    counts_(BUCKET_COUNT, 0),
+    totalCount_{0},
+    min_{0},
+    max_{0},
+    sum_{0}
+{
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @return The number of recorded values.
+*/
+unsigned long long Histogram::getCount() const
+{
+    return totalCount_;
+}
+
+/*
+    @return The smallest recorded value, or 0 if nothing was recorded.
+*/
+unsigned long long Histogram::getMin() const
+{
+    return min_;
+}
+
+/*
+    @return The largest recorded value, or 0 if nothing was recorded.
+*/
+unsigned long long Histogram::getMax() const
+{
+    return max_;
+}
+
+/*
+    @return The exact mean of the recorded values, or 0 if nothing was recorded.
+*/
+double Histogram::getMean() const
+{
+    if (totalCount_ == 0)
+        return 0;
+    return static_cast<double>(sum_ / totalCount_);
+}
+
+/*
+    @param  The percentile to look up, from 0 to 100.
+    @return The highest value equivalent to the one found at the given percentile, clamped to the recorded maximum.
+            0 if nothing was recorded.
+*/
+unsigned long long Histogram::getValueAtPercentile(const double& percentile) const
+{
+    if (totalCount_ == 0)
+        return 0;
+
+    double clampedPercentile = percentile < 0 ? 0 : (percentile > 100 ? 100 : percentile);
+    unsigned long long rank = static_cast<unsigned long long>(clampedPercentile / 100.0 * totalCount_ + 0.5);
+    if (rank == 0)
+        rank = 1;
+
+    unsigned long long seen{0};
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += counts_[i];
+        if (seen >= rank)
+        {
+            unsigned long long value = highestValueInBucket(i);
+            if (value > max_)
+                value = max_;
+            if (value < min_)
+                value = min_;
+            return value;
+        }
+    }
+    return max_;
+}
+
+/*
+    @return The count, min, max, mean, p50, p95 and p99 of the recorded values.
+*/
+PercentileSummary Histogram::getSummary() const
+{
+    PercentileSummary summary;
+    summary.count = totalCount_;
+    summary.min = min_;
+    summary.max = max_;
+    summary.mean = getMean();
+    summary.p50 = getValueAtPercentile(50);
+    summary.p95 = getValueAtPercentile(95);
+    summary.p99 = getValueAtPercentile(99);
+    return summary;
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  The value to record.
+    @post   The bucket holding the value is incremented. Runs in constant time.
+*/
+void Histogram::record(const unsigned long long& value)
+{
+    record(value, 1);
+}
+
+/*
+    @param  The value to record.
+    @param  How many times the value occurred.
+    @post   The bucket holding the value is incremented by the given count. Runs in constant time.
+*/
+void Histogram::record(const unsigned long long& value, const unsigned long long& count)
+{
+    if (count == 0)
+        return;
+
+    if (totalCount_ == 0 || value < min_)
+        min_ = value;
+    if (totalCount_ == 0 || value > max_)
+        max_ = value;
+
+    counts_[bucketIndex(value)] += count;
+    totalCount_ += count;
+    sum_ += static_cast<long double>(value) * count;
+}
+
+/*
+    @param  A const lvalue reference to another histogram.
+    @post   Every value recorded in the parameter is added to this histogram.
+*/
+void Histogram::merge(const Histogram& rhs)
+{
+    if (rhs.totalCount_ == 0)
+        return;
+
+    if (totalCount_ == 0 || rhs.min_ < min_)
+        min_ = rhs.min_;
+    if (totalCount_ == 0 || rhs.max_ > max_)
+        max_ = rhs.max_;
+
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++)
+        counts_[i] += rhs.counts_[i];
+    totalCount_ += rhs.totalCount_;
+    sum_ += rhs.sum_;
+}
+
+/*
+    @post   Every recorded value is discarded.
+*/
+void Histogram::reset()
+{
+    std::fill(counts_.begin(), counts_.end(), 0);
+    totalCount_ = 0;
+    min_ = 0;
+    max_ = 0;
+    sum_ = 0;
+}
+
+/*
+    @param  A value.
+    @return The index of the bucket that counts the value.
+            Values below SUB_BUCKET_COUNT map one-to-one, larger values keep their SUB_BUCKET_BITS most significant bits.
+*/
+unsigned int Histogram::bucketIndex(const unsigned long long& value)
+{
+    if (value < SUB_BUCKET_COUNT)
+        return static_cast<unsigned int>(value);
+
+#if defined(__GNUC__)
+    unsigned int mostSignificantBit = 63 - __builtin_clzll(value);
+#else
+    unsigned int mostSignificantBit = 0;
+    for (unsigned long long remaining = value; remaining > 1; remaining >>= 1)
+        mostSignificantBit++;
+#endif
+    unsigned int shift = mostSignificantBit - (SUB_BUCKET_BITS - 1);
+    return shift * SUB_BUCKET_HALF + static_cast<unsigned int>(value >> shift);
+}
+
+/*
+    @param  A bucket index.
+    @return The largest value that is counted by the bucket.
+*/
+unsigned long long Histogram::highestValueInBucket(const unsigned int& index)
+{
+    if (index < SUB_BUCKET_COUNT)
+        return index;
+
+    unsigned int shift = index / SUB_BUCKET_HALF - 1;
+    unsigned long long subBucket = index % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The bucket counts and the running totals are appended to the checkpoint.
+*/
+void Histogram::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.writeArray(counts_);
+    writer.write(totalCount_);
+    writer.write(min_);
+    writer.write(max_);
+    writer.write(sum_);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The histogram holds the samples it held when the checkpoint was written.
+
+    @note   If the checkpoint has a different number of buckets, throw std::runtime_error exception.
+*/
+void Histogram::readCheckpoint(CheckpointReader& reader)
+{
+    reader.readArray(counts_);
+    if (counts_.size() != BUCKET_COUNT)
+        throw std::runtime_error("The checkpoint has a histogram with a different number of buckets");
+    totalCount_ = reader.read<unsigned long long>();
+    min_ = reader.read<unsigned long long>();
+    max_ = reader.read<unsigned long long>();
+    sum_ = reader.read<long double>();
+}
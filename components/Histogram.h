@@ -0,0 +1,62 @@
+// Alan Tuecci
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+#include <vector>
+#include <algorithm>
+#include "Checkpoint.h"
+
+struct PercentileSummary
+{
+    unsigned long long count{0};
+    unsigned long long min{0};
+    unsigned long long max{0};
+    double mean{0};
+    unsigned long long p50{0};
+    unsigned long long p95{0};
+    unsigned long long p99{0};
+};
+
+/*
+    Log-linear (HDR-style) histogram of unsigned values.
+    Values below 2^SUB_BUCKET_BITS are counted exactly, larger values land in buckets whose width is at most 1/64th of the value.
+    Recording is constant-time and the memory used does not depend on the number of samples.
+*/
+class Histogram
+{
+public:
+    //Constructors
+    Histogram();
+
+    //Getters
+    unsigned long long getCount() const;
+    unsigned long long getMin() const;
+    unsigned long long getMax() const;
+    double getMean() const;
+    unsigned long long getValueAtPercentile(const double& percentile) const;
+    PercentileSummary getSummary() const;
+
+    //Utilities
+    void record(const unsigned long long& value);
+    void record(const unsigned long long& value, const unsigned long long& count);
+    void merge(const Histogram& rhs);
+    void reset();
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    static constexpr unsigned int SUB_BUCKET_BITS{7};
+    static constexpr unsigned int SUB_BUCKET_COUNT{1u << SUB_BUCKET_BITS};
+    static constexpr unsigned int SUB_BUCKET_HALF{SUB_BUCKET_COUNT / 2};
+    static constexpr unsigned int BUCKET_COUNT{(64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_HALF + SUB_BUCKET_HALF};
+
+    static unsigned int bucketIndex(const unsigned long long& value);
+    static unsigned long long highestValueInBucket(const unsigned int& index);
+
+    std::vector<unsigned long long> counts_;
+    unsigned long long totalCount_;
+    unsigned long long min_;
+    unsigned long long max_;
+    long double sum_;
+};
+#endif
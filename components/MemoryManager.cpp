@@ -9,7 +9,8 @@
 MemoryManager::MemoryManager():
     amountOfRam_{0},
     pageSize_{0},
-    numPages_{0}
+    numPages_{0},
+    fileCacheEnabled_{false}
 {
 }
 
@@ -22,9 +23,10 @@ MemoryManager::MemoryManager():
 MemoryManager::MemoryManager(const unsigned long long& amountOfRam, const unsigned int& pageSize):
     amountOfRam_{amountOfRam},
     pageSize_{pageSize},
-    numPages_{amountOfRam/pageSize}
+    numPages_{amountOfRam/pageSize},
+    fileCacheEnabled_{false}
 {
-    MemoryItem placeHolder{0, 0, 0};
+    MemoryItem placeHolder{0, 0, 0, 0, 0};
     for(unsigned int i = 0; i < numPages_; i++)
     {  
         previouslyUsedFrames_.push_back(i);
@@ -93,21 +95,151 @@ MemoryUsage MemoryManager::getMemoryUsage() const
     @param  A const lvalue reference to the logical address to be accessed.
     @post   If the page associated with the provided address is already loaded, only the previouslyUsedFrames list is updated so that it reflects that the frame was just used.
             If it isn't loaded, then the system checks to see if the least recently used frame is already allocated, and if it is, then the new page replaces the existing one.
+            Same as accessing the address with the LRUReplacement policy.
+    @return True if the page had to be loaded into a frame (a page fault), false if it was already loaded.
 */
-void MemoryManager::accessMemoryAtAddress(const int& processID, const unsigned long long& address)
+bool MemoryManager::accessMemoryAtAddress(const int& processID, const unsigned long long& address)
 {
-    //If the page is already loaded, find out what frame it's in and update the previouslyUsedFrames list accordingly
-    for(MemoryUsage::iterator i = memory_.begin(); i != memory_.end(); i++)
+    return accessMemoryAtAddress(LRUReplacement(), processID, address);
+}
+
+/*
+    @param  A const lvalue reference to the logical address.
+    @return The page number associated with that address.
+*/
+unsigned long long MemoryManager::getPageNumber(const unsigned long long& address)
+{
+    return address / pageSize_;
+}
+
+/*
+    @param  A const lvalue reference to the process ID.
+    @post   Any frames used by a process with a PID that's the same as the argument are immediately deleted.
+            The freed frames are sent to the front of the recently used frames list.
+*/
+void MemoryManager::findAndClearMemoryUsedByAProcess(const int& processID)
+{
+    findAndClearMemoryUsedByProcesses([&processID](const int& pid) { return pid == processID; });
+}
+
+/*
+    @param  A const lvalue reference to the process IDs.
+    @post   All memory used by the processes is cleared, and the frames they used are marked as least recently used.
+            Memory and the previously used frames list are each walked once, no matter how many processes are cleared.
+*/
+void MemoryManager::findAndClearMemoryUsedByProcesses(const std::vector<int>& processIDs)
+{
+    if (processIDs.empty() || (memory_.empty() && attachments_.empty()))
+        return;
+
+    std::vector<int> sortedProcessIDs = processIDs;
+    std::sort(sortedProcessIDs.begin(), sortedProcessIDs.end());
+    findAndClearMemoryUsedByProcesses([&sortedProcessIDs](const int& processID) { return std::binary_search(sortedProcessIDs.begin(), sortedProcessIDs.end(), processID); });
+}
+
+/*
+    @param  The number of the frame to mark as least recently used.
+    @post   Marks the number of the frame as least recently used by sending it to the front of the previously used frames list.
+*/
+void MemoryManager::findAFrameAndSendItToFront(const unsigned long long& frameNumber)
+{
+    for(std::list<unsigned long long>::iterator i = previouslyUsedFrames_.begin(); i != previouslyUsedFrames_.end(); i++)
+    {
+        if(*i == frameNumber)
+        {
+            previouslyUsedFrames_.erase(i);
+            previouslyUsedFrames_.push_front(frameNumber);
+            break;
+        }
+    }
+}
+
+/*
+    @param  The number of the frame to mark as most recently used.
+    @post   Marks the number of the frame as most recently used by sending it to the back of the previously used frames list.
+*/
+void MemoryManager::findAFrameAndSendItToBack(const unsigned long long& frameNumber)
+{
+    for(std::list<unsigned long long>::iterator i = previouslyUsedFrames_.begin(); i != previouslyUsedFrames_.end(); i++)
     {
-        if(i->pageNumber == (address/pageSize_))
+        if(*i == frameNumber)
         {
-            findAFrameAndSendItToBack(i->frameNumber);
-            return;
+            previouslyUsedFrames_.erase(i);
+            previouslyUsedFrames_.push_back(frameNumber);
+            break;
         }
     }
+}
+
+//--------------------------------------------File Block Cache--------------------------------------------
+
+/*
+    @param  True to cache the blocks of files read from the disks in memory frames, false to stop caching.
+    @post   With caching off, no new blocks are cached, and reads always go to the disk. Blocks already cached stay until their frames are replaced.
+*/
+void MemoryManager::setFileCacheEnabled(const bool& enabled)
+{
+    fileCacheEnabled_ = enabled;
+}
+
+/*
+    @return True if file blocks are cached.
+*/
+bool MemoryManager::isFileCacheEnabled() const
+{
+    return fileCacheEnabled_;
+}
+
+/*
+    @param  A const lvalue reference to the number of the disk the file is on.
+    @param  A const lvalue reference to the ID of the file's name.
+    @post   If caching is on and the file's block isn't cached yet, it is loaded into the least recently used frame, replacing whatever page or block is there.
+*/
+void MemoryManager::cacheFileBlock(const int& diskNumber, const int& fileNameID)
+{
+    if (!fileCacheEnabled_)
+        return;
+    std::map<std::pair<int, int>, int>::iterator file = fileIDs_.find(std::make_pair(diskNumber, fileNameID));
+    if (file == fileIDs_.end())
+        file = fileIDs_.emplace(std::make_pair(diskNumber, fileNameID), static_cast<int>(fileIDs_.size()) + 1).first;
+    else if (std::any_of(memory_.begin(), memory_.end(), [&file](const MemoryItem& item) { return item.fileID == file->second; }))
+        return;
+    loadIntoLeastRecentlyUsedFrame(MemoryItem{0, 0, NO_PROCESS, 0, file->second});
+}
+
+/*
+    @param  A const lvalue reference to the number of disk requests a hit didn't queue behind.
+    @param  A const lvalue reference to the estimated time the hit didn't wait for the disk.
+    @post   The savings are added to the cache statistics.
+*/
+void MemoryManager::recordTimeSaved(const unsigned long long& requestsSkipped, const unsigned long long& timeSaved)
+{
+    fileCacheStats_.requestsSkipped += requestsSkipped;
+    fileCacheStats_.timeSaved += timeSaved;
+}
+
+/*
+    @return The hits, misses and hit rate of the file block cache, the disk time the hits saved, and the number of blocks cached.
+*/
+FileCacheStats MemoryManager::getFileCacheStats() const
+{
+    FileCacheStats stats = fileCacheStats_;
+    if (stats.hits + stats.misses != 0)
+        stats.hitRate = static_cast<double>(stats.hits) / (stats.hits + stats.misses);
+    stats.cachedBlocks = std::count_if(memory_.begin(), memory_.end(), [](const MemoryItem& item) { return item.fileID != 0; });
+    return stats;
+}
 
+/*
+    @param  A const lvalue reference to the page or file block to load; its frame number is ignored.
+    @post   The item is loaded into the frame at the front of the previously used frames list, replacing whatever was in the frame,
+            and the frame is marked as the most recently used.
+*/
+void MemoryManager::loadIntoLeastRecentlyUsedFrame(const MemoryItem& item)
+{
     //Create a memoryItem object with the frame number being that of the frame that was least recently used
-    MemoryItem memoryAccess{(address/pageSize_), previouslyUsedFrames_.front(), processID};
+    MemoryItem memoryAccess = item;
+    memoryAccess.frameNumber = previouslyUsedFrames_.front();
 
     //Send the frame to the back since it's now the most recently used frame
     previouslyUsedFrames_.push_back(memoryAccess.frameNumber);
@@ -129,64 +261,219 @@ void MemoryManager::accessMemoryAtAddress(const int& processID, const unsigned l
         memory_.push_back(memoryAccess);
 }
 
+//--------------------------------------------Shared Memory--------------------------------------------
+
 /*
-    @param  A const lvalue reference to the logical address.
-    @return The page number associated with that address.
+    @param  A const lvalue reference to the number of pages in the segment.
+    @post   A shared memory segment is created. No process is attached to it and none of its pages are loaded yet.
+    @return The ID of the segment, starting at 1.
+
+    @note   If the segment has no pages, throw std::invalid_argument exception.
 */
-unsigned long long MemoryManager::getPageNumber(const unsigned long long& address)
+int MemoryManager::createSharedSegment(const unsigned long long& pageCount)
 {
-    return address / pageSize_;
+    if (pageCount == 0)
+        throw std::invalid_argument("A shared memory segment needs at least one page");
+    sharedSegments_.push_back(SharedSegment{pageCount, 0});
+    return static_cast<int>(sharedSegments_.size());
 }
 
 /*
     @param  A const lvalue reference to the process ID.
-    @post   Any frames used by a process with a PID that's the same as the argument are immediately deleted.
-            The freed frames are sent to the front of the recently used frames list.
+    @param  A const lvalue reference to the segment ID.
+    @param  A const lvalue reference to the page of the process the segment starts at.
+    @post   The pages of the process from firstPage on map to the frames of the segment, and the segment counts one more attached process.
+
+    @note   If there is no such segment, throw std::out_of_range exception.
+    @note   If the pages overlap a segment the process already attached, throw std::invalid_argument exception.
 */
-void MemoryManager::findAndClearMemoryUsedByAProcess(const int& processID)
+void MemoryManager::attachSharedSegment(const int& processID, const int& segmentID, const unsigned long long& firstPage)
 {
-    for(MemoryUsage::iterator i = memory_.begin(); i < memory_.end(); )
+    unsigned long long pageCount = findSegment(segmentID).pageCount;
+    std::vector<SegmentAttachment>& attachments = attachments_[processID];
+    for (const SegmentAttachment& attachment : attachments)
     {
-        if(i->PID == processID)
+        if (attachment.segmentID == segmentID || (firstPage < attachment.firstPage + attachment.pageCount && attachment.firstPage < firstPage + pageCount))
+            throw std::invalid_argument("The process already has a shared memory segment attached at these pages");
+    }
+    attachments.push_back(SegmentAttachment{segmentID, firstPage, pageCount});
+    sharedSegments_[segmentID - 1].attachedProcesses++;
+}
+
+/*
+    @param  A const lvalue reference to the process ID.
+    @param  A const lvalue reference to the segment ID.
+    @post   The process no longer maps the segment. If it was the last process attached, the frames of the segment are freed and marked as least recently used.
+
+    @note   If the process isn't attached to the segment, throw std::logic_error exception.
+*/
+void MemoryManager::detachSharedSegment(const int& processID, const int& segmentID)
+{
+    std::unordered_map<int, std::vector<SegmentAttachment>>::iterator attachments = attachments_.find(processID);
+    if (attachments != attachments_.end())
+    {
+        for (std::vector<SegmentAttachment>::iterator i = attachments->second.begin(); i != attachments->second.end(); i++)
         {
-            findAFrameAndSendItToFront(i->frameNumber);
-            i = memory_.erase(i);
+            if (i->segmentID == segmentID)
+            {
+                releaseAttachment(*i);
+                attachments->second.erase(i);
+                if (attachments->second.empty())
+                    attachments_.erase(attachments);
+                if (sharedSegments_[segmentID - 1].attachedProcesses == 0)
+                    findAndClearMemoryUsedByProcesses([](const int&) { return false; });
+                return;
+            }
         }
-        else
-            ++i;
     }
+    throw std::logic_error("The process isn't attached to this shared memory segment");
 }
 
 /*
-    @param  The number of the frame to mark as least recently used.
-    @post   Marks the number of the frame as least recently used by sending it to the front of the previously used frames list.
+    @param  A const lvalue reference to the segment ID.
+    @return The number of processes attached to the segment, which is the reference count of each of its frames.
+
+    @note   If there is no such segment, throw std::out_of_range exception.
 */
-void MemoryManager::findAFrameAndSendItToFront(const unsigned long long& frameNumber)
+unsigned int MemoryManager::getAttachedProcessCount(const int& segmentID) const
 {
-    for(std::list<unsigned long long>::iterator i = previouslyUsedFrames_.begin(); i != previouslyUsedFrames_.end(); i++)
+    return findSegment(segmentID).attachedProcesses;
+}
+
+/*
+    @param  A const lvalue reference to the segment ID.
+    @return A const reference to the segment.
+
+    @note   If there is no such segment, throw std::out_of_range exception.
+*/
+const MemoryManager::SharedSegment& MemoryManager::findSegment(const int& segmentID) const
+{
+    if (segmentID < 1 || static_cast<std::size_t>(segmentID) > sharedSegments_.size())
+        throw std::out_of_range("There is no shared memory segment with this ID");
+    return sharedSegments_[segmentID - 1];
+}
+
+/*
+    @param  A const lvalue reference to the process ID.
+    @param  A reference to a page of the process, which becomes the page within the segment if it is shared.
+    @param  A reference that receives the segment ID of a shared page.
+    @return True if the page lies in a shared memory segment attached by the process.
+*/
+bool MemoryManager::translatePage(const int& processID, unsigned long long& pageNumber, int& segmentID) const
+{
+    if (attachments_.empty())
+        return false;
+    std::unordered_map<int, std::vector<SegmentAttachment>>::const_iterator attachments = attachments_.find(processID);
+    if (attachments == attachments_.end())
+        return false;
+    for (const SegmentAttachment& attachment : attachments->second)
     {
-        if(*i == frameNumber)
+        if (pageNumber >= attachment.firstPage && pageNumber - attachment.firstPage < attachment.pageCount)
         {
-            previouslyUsedFrames_.erase(i);
-            previouslyUsedFrames_.push_front(frameNumber);
-            break;
+            pageNumber -= attachment.firstPage;
+            segmentID = attachment.segmentID;
+            return true;
         }
     }
+    return false;
 }
 
 /*
-    @param  The number of the frame to mark as most recently used.
-    @post   Marks the number of the frame as most recently used by sending it to the back of the previously used frames list.
+    @param  A const lvalue reference to an attachment being removed.
+    @post   The segment counts one less attached process. Its frames are not freed here.
 */
-void MemoryManager::findAFrameAndSendItToBack(const unsigned long long& frameNumber)
+void MemoryManager::releaseAttachment(const SegmentAttachment& attachment)
 {
-    for(std::list<unsigned long long>::iterator i = previouslyUsedFrames_.begin(); i != previouslyUsedFrames_.end(); i++)
+    sharedSegments_[attachment.segmentID - 1].attachedProcesses--;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The RAM geometry, the frames in use, the "recently used" order of the frames, the shared memory segments with their attachments
+            and the files of the file block cache are appended to the checkpoint.
+*/
+void MemoryManager::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(amountOfRam_);
+    writer.write(pageSize_);
+    writer.write(numPages_);
+    writer.writeArray(memory_);
+    writer.writeArray(std::vector<unsigned long long>(previouslyUsedFrames_.begin(), previouslyUsedFrames_.end()));
+    writer.writeArray(sharedSegments_);
+    std::vector<int> attachedProcessIDs;
+    std::vector<SegmentAttachment> attachments;
+    for (const std::pair<const int, std::vector<SegmentAttachment>>& process : attachments_)
     {
-        if(*i == frameNumber)
+        for (const SegmentAttachment& attachment : process.second)
         {
-            previouslyUsedFrames_.erase(i);
-            previouslyUsedFrames_.push_back(frameNumber);
-            break;
+            attachedProcessIDs.push_back(process.first);
+            attachments.push_back(attachment);
         }
     }
-}
\ No newline at end of file
+    writer.writeArray(attachedProcessIDs);
+    writer.writeArray(attachments);
+
+    writer.write(fileCacheEnabled_);
+    std::vector<int> fileDisks;
+    std::vector<int> fileNameIDs;
+    std::vector<int> fileIDs;
+    for (const std::pair<const std::pair<int, int>, int>& file : fileIDs_)
+    {
+        fileDisks.push_back(file.first.first);
+        fileNameIDs.push_back(file.first.second);
+        fileIDs.push_back(file.second);
+    }
+    writer.writeArray(fileDisks);
+    writer.writeArray(fileNameIDs);
+    writer.writeArray(fileIDs);
+    writer.write(fileCacheStats_);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The memory is in the state it was in when the checkpoint was written.
+
+    @note   If the "recently used" order doesn't list every frame, throw std::runtime_error exception.
+*/
+void MemoryManager::readCheckpoint(CheckpointReader& reader)
+{
+    amountOfRam_ = reader.read<unsigned long long>();
+    pageSize_ = reader.read<unsigned int>();
+    numPages_ = reader.read<unsigned int>();
+    reader.readArray(memory_);
+    std::vector<unsigned long long> previouslyUsedFrames;
+    reader.readArray(previouslyUsedFrames);
+    if (previouslyUsedFrames.size() != numPages_)
+        throw std::runtime_error("The checkpoint has a corrupt frame order");
+    previouslyUsedFrames_.assign(previouslyUsedFrames.begin(), previouslyUsedFrames.end());
+    reader.readArray(sharedSegments_);
+    std::vector<int> attachedProcessIDs;
+    std::vector<SegmentAttachment> attachments;
+    reader.readArray(attachedProcessIDs);
+    reader.readArray(attachments);
+    if (attachedProcessIDs.size() != attachments.size())
+        throw std::runtime_error("The checkpoint has corrupt shared memory attachments");
+    attachments_.clear();
+    for (std::size_t i = 0; i < attachments.size(); i++)
+    {
+        if (attachments[i].segmentID < 1 || static_cast<std::size_t>(attachments[i].segmentID) > sharedSegments_.size())
+            throw std::runtime_error("The checkpoint has corrupt shared memory attachments");
+        attachments_[attachedProcessIDs[i]].push_back(attachments[i]);
+    }
+
+    fileCacheEnabled_ = reader.read<bool>();
+    std::vector<int> fileDisks;
+    std::vector<int> fileNameIDs;
+    std::vector<int> fileIDs;
+    reader.readArray(fileDisks);
+    reader.readArray(fileNameIDs);
+    reader.readArray(fileIDs);
+    if (fileDisks.size() != fileIDs.size() || fileNameIDs.size() != fileIDs.size())
+        throw std::runtime_error("The checkpoint has a corrupt file block cache");
+    fileIDs_.clear();
+    for (std::size_t i = 0; i < fileIDs.size(); i++)
+        fileIDs_[std::make_pair(fileDisks[i], fileNameIDs[i])] = fileIDs[i];
+    fileCacheStats_ = reader.read<FileCacheStats>();
+}
@@ -5,17 +5,45 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <unordered_map>
+#include <map>
+#include <stdexcept>
 #include "Process.h"
+#include "Checkpoint.h"
 
 struct MemoryItem
 {
     unsigned long long pageNumber;
     unsigned long long frameNumber;
-    int PID; // PID of the process using this frame of memory
+    int PID; // PID of the process using this frame of memory, NO_PROCESS for a frame of a shared memory segment
+    int segmentID; // Shared memory segment the frame belongs to, with pageNumber counted from the start of the segment; 0 for a private frame
+    int fileID; // File block cached in the frame, with PID NO_PROCESS and pageNumber 0; 0 for a page of memory
+};
+
+struct FileCacheStats
+{
+    unsigned long long hits{0};
+    unsigned long long misses{0};
+    double hitRate{0};
+    unsigned long long requestsSkipped{0};  //Disk requests the hits would have queued behind
+    unsigned long long timeSaved{0};        //Estimated disk queue and service time the hits didn't wait for
+    unsigned long long cachedBlocks{0};     //Frames holding a file block right now
 };
 
 using MemoryUsage = std::vector<MemoryItem>;
 
+//Page replacement policies. Frames are always replaced starting from the front of the previously used frames list;
+//a policy decides whether a hit moves its frame to the back.
+struct LRUReplacement
+{
+    bool refreshesOnHit() const { return true; }    //Least recently used: every access makes the frame the last to be replaced
+};
+
+struct FIFOReplacement
+{
+    bool refreshesOnHit() const { return false; }   //First in, first out: frames are replaced in the order they were loaded
+};
+
 class MemoryManager
 {
 public:
@@ -34,17 +62,180 @@ public:
     MemoryUsage getMemoryUsage() const;
 
     //Utilites
-    void accessMemoryAtAddress(const int& processID, const unsigned long long& address);
+    bool accessMemoryAtAddress(const int& processID, const unsigned long long& address);
+    template <class Replacement>
+    bool accessMemoryAtAddress(const Replacement& replacement, const int& processID, const unsigned long long& address);
     unsigned long long getPageNumber(const unsigned long long& address);
     void findAndClearMemoryUsedByAProcess(const int& processID);
+    void findAndClearMemoryUsedByProcesses(const std::vector<int>& processIDs);
+    template <class Predicate>
+    void findAndClearMemoryUsedByProcesses(const Predicate& isCleared);
     void findAFrameAndSendItToFront(const unsigned long long& frameNumber);
     void findAFrameAndSendItToBack(const unsigned long long& frameNumber);
+
+    //File Block Cache
+    void setFileCacheEnabled(const bool& enabled);
+    bool isFileCacheEnabled() const;
+    template <class Replacement>
+    bool readFileBlock(const Replacement& replacement, const int& diskNumber, const int& fileNameID);
+    void cacheFileBlock(const int& diskNumber, const int& fileNameID);
+    void recordTimeSaved(const unsigned long long& requestsSkipped, const unsigned long long& timeSaved);
+    FileCacheStats getFileCacheStats() const;
+
+    //Shared Memory
+    int createSharedSegment(const unsigned long long& pageCount);
+    void attachSharedSegment(const int& processID, const int& segmentID, const unsigned long long& firstPage);
+    void detachSharedSegment(const int& processID, const int& segmentID);
+    unsigned int getAttachedProcessCount(const int& segmentID) const;
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
 private:
+    struct SharedSegment
+    {
+        unsigned long long pageCount;
+        unsigned int attachedProcesses;  //Reference count of every frame of the segment; the frames are freed when it drops to 0
+    };
+    struct SegmentAttachment
+    {
+        int segmentID;
+        unsigned long long firstPage;    //Page of the process the segment starts at
+        unsigned long long pageCount;
+    };
+
+    const SharedSegment& findSegment(const int& segmentID) const;
+    bool translatePage(const int& processID, unsigned long long& pageNumber, int& segmentID) const;
+    void releaseAttachment(const SegmentAttachment& attachment);
+    void loadIntoLeastRecentlyUsedFrame(const MemoryItem& memoryAccess);
+
     unsigned long long amountOfRam_;
     unsigned int pageSize_;
     unsigned int numPages_;
     
     MemoryUsage memory_;
     std::list<unsigned long long> previouslyUsedFrames_;
+
+    std::vector<SharedSegment> sharedSegments_;     //Indexed by segment ID - 1
+    std::unordered_map<int, std::vector<SegmentAttachment>> attachments_;  //Segments attached by each process
+
+    bool fileCacheEnabled_;
+    std::map<std::pair<int, int>, int> fileIDs_;   //ID of the cache block of each file read, by disk and file name ID
+    FileCacheStats fileCacheStats_;
+
+    //Scratch space for clearing memory in bulk, kept between calls so clearing doesn't allocate once it has grown
+    std::vector<unsigned long long> freedFrames_;
+    std::vector<std::list<unsigned long long>::iterator> framePositions_;
 };
+
+/*
+    @param  A const lvalue reference to the page replacement policy.
+    @param  A const lvalue reference to the process ID.
+    @param  A const lvalue reference to the logical address to be accessed.
+    @post   If the page associated with the provided address is already loaded, the policy decides whether the previouslyUsedFrames list is updated so that it reflects that the frame was just used.
+            If it isn't loaded, then the system checks to see if the frame at the front of the previouslyUsedFrames list is already allocated, and if it is, then the new page replaces the existing one.
+            The policy is a template parameter so its decision is inlined into the access.
+            Pages are private to the process, except in the ranges where it attached a shared memory segment.
+            Every process attached to a segment uses the same frame for a page of the segment.
+    @return True if the page had to be loaded into a frame (a page fault), false if it was already loaded.
+*/
+template <class Replacement>
+bool MemoryManager::accessMemoryAtAddress(const Replacement& replacement, const int& processID, const unsigned long long& address)
+{
+    unsigned long long pageNumber = address/pageSize_;
+    int segmentID{0};
+    int owner = translatePage(processID, pageNumber, segmentID) ? NO_PROCESS : processID;
+
+    //If the page is already loaded, find out what frame it's in and update the previouslyUsedFrames list accordingly
+    for(MemoryUsage::iterator i = memory_.begin(); i != memory_.end(); i++)
+    {
+        if(i->pageNumber == pageNumber && i->PID == owner && i->segmentID == segmentID)
+        {
+            if(replacement.refreshesOnHit())
+                findAFrameAndSendItToBack(i->frameNumber);
+            return false;
+        }
+    }
+
+    loadIntoLeastRecentlyUsedFrame(MemoryItem{pageNumber, 0, owner, segmentID, 0});
+    return true;
+}
+
+/*
+    @param  A const lvalue reference to the page replacement policy.
+    @param  A const lvalue reference to the number of the disk the file is on.
+    @param  A const lvalue reference to the ID of the file's name.
+    @post   If the file's block is cached, the hit is counted and the policy decides whether its frame is marked as just used, like a hit on a page.
+            Otherwise the miss is counted; the block is cached by cacheFileBlock() once the disk has read it.
+    @return True if the block was cached (a hit), false otherwise.
+*/
+template <class Replacement>
+bool MemoryManager::readFileBlock(const Replacement& replacement, const int& diskNumber, const int& fileNameID)
+{
+    std::map<std::pair<int, int>, int>::const_iterator file = fileIDs_.find(std::make_pair(diskNumber, fileNameID));
+    if (file != fileIDs_.end())
+    {
+        for (const MemoryItem& item : memory_)
+        {
+            if (item.fileID == file->second)
+            {
+                if (replacement.refreshesOnHit())
+                    findAFrameAndSendItToBack(item.frameNumber);
+                fileCacheStats_.hits++;
+                return true;
+            }
+        }
+    }
+    fileCacheStats_.misses++;
+    return false;
+}
+
+/*
+    @param  A const lvalue reference to a function that takes a PID and returns true if the memory of the process has to be cleared.
+    @post   All memory used by such processes is cleared, and the frames they used are marked as least recently used.
+            The processes are detached from their shared memory segments; the frames of a segment are only cleared when no process is attached to it anymore.
+            Memory and the previously used frames list are each walked once, no matter how many processes are cleared.
+*/
+template <class Predicate>
+void MemoryManager::findAndClearMemoryUsedByProcesses(const Predicate& isCleared)
+{
+    for(std::unordered_map<int, std::vector<SegmentAttachment>>::iterator i = attachments_.begin(); i != attachments_.end(); )
+    {
+        if(isCleared(i->first))
+        {
+            for(const SegmentAttachment& attachment : i->second)
+                releaseAttachment(attachment);
+            i = attachments_.erase(i);
+        }
+        else
+            i++;
+    }
+
+    //Remove the pages of the processes and of the segments nobody uses anymore, remembering their frames in memory order
+    freedFrames_.clear();
+    MemoryUsage::iterator kept = memory_.begin();
+    for(MemoryUsage::iterator i = memory_.begin(); i != memory_.end(); i++)
+    {
+        if(i->segmentID != 0 ? sharedSegments_[i->segmentID - 1].attachedProcesses == 0 : isCleared(i->PID))
+            freedFrames_.push_back(i->frameNumber);
+        else
+            *kept++ = *i;
+    }
+    memory_.erase(kept, memory_.end());
+    if (freedFrames_.empty())
+        return;
+
+    //Find every freed frame in the previously used frames list in one pass, then send them to the front in the order they were freed
+    framePositions_.assign(numPages_, previouslyUsedFrames_.end());
+    for(std::list<unsigned long long>::iterator i = previouslyUsedFrames_.begin(); i != previouslyUsedFrames_.end(); i++)
+    {
+        if(*i < framePositions_.size())
+            framePositions_[*i] = i;
+    }
+    for(const unsigned long long& frameNumber : freedFrames_)
+    {
+        if(frameNumber < framePositions_.size() && framePositions_[frameNumber] != previouslyUsedFrames_.end())
+            previouslyUsedFrames_.splice(previouslyUsedFrames_.begin(), previouslyUsedFrames_, framePositions_[frameNumber]);
+    }
+}
 #endif
\ No newline at end of file
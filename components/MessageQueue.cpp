@@ -0,0 +1,189 @@
+// Alan Tuecci
+#include "MessageQueue.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   Message queue object initialized with no room for messages.
+*/
+MessageQueue::MessageQueue() : MessageQueue(0)
+{
+}
+
+/*
+    @param  A const lvalue reference to the number of messages the queue can hold.
+    @post   An empty message queue whose ring buffer is allocated once, up front.
+*/
+MessageQueue::MessageQueue(const unsigned int& capacity) :
+    ring_(capacity),
+    head_{0},
+    depth_{0},
+    waitingReceivers_{},
+    handedOff_{},
+    stats_{},
+    latency_{}
+{
+    stats_.capacity = capacity;
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @return The number of messages the queue can hold.
+*/
+unsigned int MessageQueue::getCapacity() const
+{
+    return static_cast<unsigned int>(ring_.size());
+}
+
+/*
+    @return The number of messages waiting to be received.
+*/
+unsigned int MessageQueue::getDepth() const
+{
+    return depth_;
+}
+
+/*
+    @return The PIDs of the processes blocked on the queue, in the order they will be woken.
+*/
+std::deque<int> MessageQueue::getWaitingReceivers() const
+{
+    return waitingReceivers_;
+}
+
+/*
+    @return The depth, throughput and stall counters of the queue, with the distribution of the time messages spent in it.
+*/
+MessageQueueStats MessageQueue::getStats() const
+{
+    MessageQueueStats stats = stats_;
+    stats.depth = depth_;
+    stats.waitingReceivers = static_cast<unsigned int>(waitingReceivers_.size());
+    stats.latency = latency_.getSummary();
+    return stats;
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the message.
+    @param  A reference that receives the PID of the receiver woken by the message, or NO_PROCESS if no receiver was waiting.
+    @post   If a receiver is waiting, the message is handed to the first one. Otherwise it is stored at the back of the ring buffer.
+    @return True if the message was sent, false if the queue was full.
+*/
+bool MessageQueue::send(const Message& message, int& wokenReceiver)
+{
+    wokenReceiver = NO_PROCESS;
+    if (!waitingReceivers_.empty())
+    {
+        wokenReceiver = waitingReceivers_.front();
+        waitingReceivers_.pop_front();
+        handedOff_[wokenReceiver] = message;
+    }
+    else if (depth_ == ring_.size())
+    {
+        stats_.rejectedSends++;
+        return false;
+    }
+    else
+    {
+        ring_[(head_ + depth_) % ring_.size()] = message;
+        depth_++;
+        stats_.maxDepth = std::max(stats_.maxDepth, depth_);
+    }
+    stats_.sent++;
+    return true;
+}
+
+/*
+    @param  A const lvalue reference to the PID of the receiver.
+    @param  A const lvalue reference to the current simulated time.
+    @param  A reference that receives the message.
+    @post   The receiver gets the message handed to it when it was woken, or else the oldest message in the ring buffer.
+            If there is neither, the receiver is put at the back of the wait list and the message is left empty.
+    @return True if a message was received, false if the receiver has to block.
+*/
+bool MessageQueue::receive(const int& receiver, const unsigned long long& currentTime, Message& message)
+{
+    std::unordered_map<int, Message>::iterator handedOff = handedOff_.find(receiver);
+    if (handedOff != handedOff_.end())
+    {
+        message = handedOff->second;
+        handedOff_.erase(handedOff);
+    }
+    else if (depth_ != 0)
+    {
+        message = ring_[head_];
+        head_ = (head_ + 1) % ring_.size();
+        depth_--;
+    }
+    else
+    {
+        message = Message{};
+        waitingReceivers_.push_back(receiver);
+        stats_.blockedReceives++;
+        return false;
+    }
+    stats_.received++;
+    latency_.record(currentTime - message.sentAt);
+    return true;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The ring buffer, the wait list, the handed-off messages and the counters are appended to the checkpoint.
+*/
+void MessageQueue::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.writeArray(ring_);
+    writer.write(head_);
+    writer.write(depth_);
+    writer.writeArray(std::vector<int>(waitingReceivers_.begin(), waitingReceivers_.end()));
+
+    std::vector<int> receivers;
+    std::vector<Message> messages;
+    for (const std::pair<const int, Message>& handedOff : handedOff_)
+    {
+        receivers.push_back(handedOff.first);
+        messages.push_back(handedOff.second);
+    }
+    writer.writeArray(receivers);
+    writer.writeArray(messages);
+
+    writer.write(stats_);
+    latency_.writeCheckpoint(writer);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The queue is in the state it was in when the checkpoint was written.
+
+    @note   If the ring buffer positions or the handed-off messages don't add up, throw std::runtime_error exception.
+*/
+void MessageQueue::readCheckpoint(CheckpointReader& reader)
+{
+    reader.readArray(ring_);
+    head_ = reader.read<unsigned int>();
+    depth_ = reader.read<unsigned int>();
+    if (depth_ > ring_.size() || (!ring_.empty() && head_ >= ring_.size()))
+        throw std::runtime_error("The checkpoint has a corrupt message queue");
+    std::vector<int> waitingReceivers;
+    reader.readArray(waitingReceivers);
+    waitingReceivers_.assign(waitingReceivers.begin(), waitingReceivers.end());
+
+    std::vector<int> receivers;
+    std::vector<Message> messages;
+    reader.readArray(receivers);
+    reader.readArray(messages);
+    if (receivers.size() != messages.size())
+        throw std::runtime_error("The checkpoint has a corrupt message queue");
+    handedOff_.clear();
+    for (std::size_t i = 0; i < receivers.size(); i++)
+        handedOff_[receivers[i]] = messages[i];
+
+    stats_ = reader.read<MessageQueueStats>();
+    latency_.readCheckpoint(reader);
+}
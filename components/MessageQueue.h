@@ -0,0 +1,86 @@
+// Alan Tuecci
+#ifndef MESSAGEQUEUE_H
+#define MESSAGEQUEUE_H
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include "Process.h"
+#include "Histogram.h"
+#include "Checkpoint.h"
+
+struct Message
+{
+    int sender{NO_PROCESS};         //NO_PROCESS if no message was received
+    unsigned long long handle{0};   //Handle of the payload; queues pass handles and never copy the payload itself
+    unsigned long long sentAt{0};   //Simulated time the message was sent
+};
+
+struct MessageQueueStats
+{
+    unsigned int capacity{0};
+    unsigned int depth{0};                  //Messages waiting to be received
+    unsigned int maxDepth{0};
+    unsigned int waitingReceivers{0};       //Processes blocked on the empty queue
+    unsigned long long sent{0};
+    unsigned long long received{0};
+    unsigned long long rejectedSends{0};    //Sends that found the queue full, a sign that the consumers are the bottleneck
+    unsigned long long blockedReceives{0};  //Receives that found the queue empty, a sign that the producers are the bottleneck
+    PercentileSummary latency;              //Simulated time from sending a message to receiving it
+};
+
+/*
+    Bounded queue of message handles between processes, stored in a ring buffer that never reallocates.
+    A receiver that finds the queue empty is put on the queue's wait list. The next message sent is handed to the first waiting receiver,
+    which keeps it until it receives again, so a woken receiver always gets the message that woke it.
+*/
+class MessageQueue
+{
+public:
+    //Constructors
+    MessageQueue();
+    explicit MessageQueue(const unsigned int& capacity);
+
+    //Getters
+    unsigned int getCapacity() const;
+    unsigned int getDepth() const;
+    std::deque<int> getWaitingReceivers() const;
+    MessageQueueStats getStats() const;
+
+    //Utilities
+    bool send(const Message& message, int& wokenReceiver);
+    bool receive(const int& receiver, const unsigned long long& currentTime, Message& message);
+    template <class Predicate>
+    void removeProcesses(const Predicate& shouldRemove);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    std::vector<Message> ring_;
+    unsigned int head_;     //Index of the oldest message in the ring
+    unsigned int depth_;
+    std::deque<int> waitingReceivers_;
+    std::unordered_map<int, Message> handedOff_;    //Messages handed to woken receivers that haven't received them yet
+
+    MessageQueueStats stats_;
+    Histogram latency_;
+};
+
+/*
+    @param  A const lvalue reference to a function that takes a PID and returns true if the process is gone.
+    @post   Such processes are removed from the wait list, and the messages handed to them are dropped.
+*/
+template <class Predicate>
+void MessageQueue::removeProcesses(const Predicate& shouldRemove)
+{
+    waitingReceivers_.erase(std::remove_if(waitingReceivers_.begin(), waitingReceivers_.end(), shouldRemove), waitingReceivers_.end());
+    for (std::unordered_map<int, Message>::iterator i = handedOff_.begin(); i != handedOff_.end(); )
+    {
+        if (shouldRemove(i->first))
+            i = handedOff_.erase(i);
+        else
+            i++;
+    }
+}
+#endif
@@ -1,5 +1,6 @@
 // Alan Tuecci
 #include "Process.h"
+#include <algorithm>
 
 //--------------------------------------------Constructors--------------------------------------------
 
@@ -7,15 +8,17 @@
     @post   Process ID set to 0.
             Process State set to 'NEW'.
             Process Type set to 'REGULAR'.
-            Child Processes vector initialized to an empty state.
+            Child Processes record initialized to an empty state.
             Parent Process ID set to 0.
 */
 Process::Process():
     processID_{0},
     processState_{NEW},
     processType_{REGULAR},
-    childProcesses_{},
-    parentProcessID_{0}
+    parentProcessID_{0},
+    inlineChildren_{},
+    inlineChildCount_{0},
+    spilledChildren_{}
 {
 }
 
@@ -24,15 +27,17 @@ Process::Process():
     @post   Process ID set to the value of the process ID parameter.
             Process State set to 'NEW'.
             Process Type set to 'REGULAR'.
-            Child Processes vector initialized to an empty state.
+            Child Processes record initialized to an empty state.
             Parent Process ID set to 0.
 */
 Process::Process(const int& processID):
     processID_{processID},
     processState_{NEW},
     processType_{REGULAR},
-    childProcesses_{},
-    parentProcessID_{0}
+    parentProcessID_{0},
+    inlineChildren_{},
+    inlineChildCount_{0},
+    spilledChildren_{}
 {
 }
 
@@ -43,15 +48,17 @@ Process::Process(const int& processID):
     @post   Process ID set to the value of the process ID parameter.
             Process State set to the value of the process State parameter.
             Process Type set to 'REGULAR'.
-            Child Processes vector initialized to an empty state.
+            Child Processes record initialized to an empty state.
             Parent Process ID set to 0.
 */
 Process::Process(const int& processID, const int& processState):
     processID_{processID},
     processState_{processState},
     processType_{REGULAR},
-    childProcesses_{},
-    parentProcessID_{0}
+    parentProcessID_{0},
+    inlineChildren_{},
+    inlineChildCount_{0},
+    spilledChildren_{}
 {
 }
 
@@ -64,15 +71,17 @@ Process::Process(const int& processID, const int& processState):
     @post   Process ID set to the value of the process ID parameter.
             Process State set to the value of the process State parameter.
             Process Type set to the value of the process Type parameter.
-            Child Processes vector initialized to an empty state.
+            Child Processes record initialized to an empty state.
             Parent Process ID set to 0.
 */
 Process::Process(const int& processID, const int& processState, const Type& processType):
     processID_{processID},
     processState_{processState},
     processType_{processType},
-    childProcesses_{},
-    parentProcessID_{0}
+    parentProcessID_{0},
+    inlineChildren_{},
+    inlineChildCount_{0},
+    spilledChildren_{}
 {
 }
 
@@ -86,15 +95,17 @@ Process::Process(const int& processID, const int& processState, const Type& proc
     @post   Process ID set to the value of the process ID parameter.
             Process State set to the value of the process State parameter.
             Process Type set to the value of the process Type parameter.
-            Child Processes vector initialized to an empty state.
+            Child Processes record initialized to an empty state.
             Parent Process ID set to 0.
 */
 Process::Process(const int& processID, const int& processState, const Type& processType, const int& parentProcessID):
     processID_{processID},
     processState_{processState},
     processType_{processType},
-    childProcesses_{},
-    parentProcessID_{parentProcessID}
+    parentProcessID_{parentProcessID},
+    inlineChildren_{},
+    inlineChildCount_{0},
+    spilledChildren_{}
 {
 }
 
@@ -106,9 +117,12 @@ Process::Process(const Process& rhs):
     processID_{rhs.processID_},
     processState_{rhs.processState_},
     processType_{rhs.processType_},
-    childProcesses_{std::move(rhs.childProcesses_)},
-    parentProcessID_{rhs.parentProcessID_}
+    parentProcessID_{rhs.parentProcessID_},
+    inlineChildren_{},
+    inlineChildCount_{rhs.inlineChildCount_},
+    spilledChildren_{rhs.spilledChildren_}
 {
+    std::copy(rhs.inlineChildren_, rhs.inlineChildren_ + rhs.inlineChildCount_, inlineChildren_);
 }
 
 /*
@@ -121,8 +135,10 @@ Process& Process::operator=(const Process& rhs)
     processID_ = rhs.processID_;
     processState_ = rhs.processState_;
     processType_ = rhs.processType_;
-    childProcesses_ = std::move(rhs.childProcesses_);
     parentProcessID_ = rhs.parentProcessID_;
+    std::copy(rhs.inlineChildren_, rhs.inlineChildren_ + rhs.inlineChildCount_, inlineChildren_);
+    inlineChildCount_ = rhs.inlineChildCount_;
+    spilledChildren_ = rhs.spilledChildren_;
 
     return *this;
 }
@@ -130,28 +146,42 @@ Process& Process::operator=(const Process& rhs)
 /*
     @param  An Rvalue reference to a Process object.
     @post   Process object is initialized to be an exact copy of the parameter object.
+            The parameter object is left without children.
 */
 Process::Process(Process&& rhs):
     processID_{rhs.processID_},
     processState_{rhs.processState_},
     processType_{rhs.processType_},
-    childProcesses_{std::move(rhs.childProcesses_)},
-    parentProcessID_{rhs.parentProcessID_}
+    parentProcessID_{rhs.parentProcessID_},
+    inlineChildren_{},
+    inlineChildCount_{rhs.inlineChildCount_},
+    spilledChildren_{std::move(rhs.spilledChildren_)}
 {
+    std::copy(rhs.inlineChildren_, rhs.inlineChildren_ + rhs.inlineChildCount_, inlineChildren_);
+    rhs.inlineChildCount_ = 0;
+    rhs.spilledChildren_.clear();
 }
 
 /*
     @param  An Rvalue reference to a Process object.
     @post   Process object is set to be an exact copy of the parameter object.
+            The parameter object is left without children.
     @return A reference to the Process object.
 */
 Process& Process::operator=(Process&& rhs)
 {
+    if (this == &rhs)
+        return *this;
+
     processID_ = rhs.processID_;
     processState_ = rhs.processState_;
     processType_ = rhs.processType_;
-    childProcesses_ = std::move(childProcesses_);
     parentProcessID_ = rhs.parentProcessID_;
+    std::copy(rhs.inlineChildren_, rhs.inlineChildren_ + rhs.inlineChildCount_, inlineChildren_);
+    inlineChildCount_ = rhs.inlineChildCount_;
+    spilledChildren_ = std::move(rhs.spilledChildren_);
+    rhs.inlineChildCount_ = 0;
+    rhs.spilledChildren_.clear();
 
     return *this;
 }
@@ -212,11 +242,14 @@ Type Process::getProcessType() const
 }
 
 /*
-    @return The child processes vector.
+    @return A read-only view of the PIDs of the process's children, oldest first.
+            The view is invalidated by adding or removing a child.
 */
-std::vector<int> Process::getChildProcesses() const
+ProcessIDSpan Process::getChildProcesses() const
 {
-    return childProcesses_;
+    if (spilledChildren_.empty())
+        return ProcessIDSpan{inlineChildren_, inlineChildren_ + inlineChildCount_};
+    return ProcessIDSpan{spilledChildren_.data(), spilledChildren_.data() + spilledChildren_.size()};
 }
 
 /*
@@ -232,10 +265,21 @@ int Process::getParentProcessID() const
 /*
     @param  A const Lvalue refernce to the process ID of the child process.
     @post   The child process's ID is added to the child process record.
+            Only a child beyond the inline capacity allocates, moving the whole record to the heap.
 */
 void Process::addChildProcessID(const int& childProcessID)
 {
-    childProcesses_.push_back(childProcessID);
+    if (!spilledChildren_.empty())
+        spilledChildren_.push_back(childProcessID);
+    else if (inlineChildCount_ < INLINE_CHILD_CAPACITY)
+        inlineChildren_[inlineChildCount_++] = childProcessID;
+    else
+    {
+        spilledChildren_.reserve(2 * INLINE_CHILD_CAPACITY);
+        spilledChildren_.assign(inlineChildren_, inlineChildren_ + inlineChildCount_);
+        spilledChildren_.push_back(childProcessID);
+        inlineChildCount_ = 0;
+    }
 }
 
 /*
@@ -244,13 +288,19 @@ void Process::addChildProcessID(const int& childProcessID)
 */
 void Process::removeChildProcessFromRecord(const int& childProcessID)
 {
-    for(std::vector<int>::iterator i = childProcesses_.begin(); i != childProcesses_.end(); i++)
+    if (!spilledChildren_.empty())
+    {
+        std::vector<int>::iterator child = std::find(spilledChildren_.begin(), spilledChildren_.end(), childProcessID);
+        if (child != spilledChildren_.end())
+            spilledChildren_.erase(child);
+        return;
+    }
+
+    int* child = std::find(inlineChildren_, inlineChildren_ + inlineChildCount_, childProcessID);
+    if (child != inlineChildren_ + inlineChildCount_)
     {
-        if(*i = childProcessID)
-        {
-            childProcesses_.erase(i);
-            break;
-        }
+        std::copy(child + 1, inlineChildren_ + inlineChildCount_, child);
+        inlineChildCount_--;
     }
 }
 
@@ -10,6 +10,59 @@ constexpr int RUNNING{3};       //Indicates that the process is currently runnin
 constexpr int WAITING{4};       //Indicates that the process is in an I/O queue (most likely the disk queue)
 constexpr int TERMINATED{5};    //Indicates that the process is terminated. Terminated processes hold no memory or disk space
 
+//A PID is a process table slot tagged with the generation of the slot, so a recycled slot never hands out a PID that was used before.
+//Generation 0 PIDs are equal to their slot numbers and may use any slot, so PIDs handed out without recycling stay sequential.
+//Later generations set RECYCLED_PROCESS_BIT and keep the generation above the slot, which limits recycling to the first MAX_RECYCLED_PROCESS_SLOTS slots.
+constexpr int PROCESS_SLOT_BITS{24};                                //Slot bits of a recycled PID
+constexpr int PROCESS_GENERATION_BITS{6};
+constexpr int RECYCLED_PROCESS_BIT{1 << (PROCESS_SLOT_BITS + PROCESS_GENERATION_BITS)};
+constexpr int MAX_PROCESS_SLOTS{RECYCLED_PROCESS_BIT};
+constexpr int MAX_RECYCLED_PROCESS_SLOTS{1 << PROCESS_SLOT_BITS};
+constexpr int MAX_PROCESS_GENERATION{1 << PROCESS_GENERATION_BITS};
+
+/*
+    @param  A const Lvalue reference to a process ID.
+    @return The process table slot the process lives in.
+*/
+inline int getProcessSlot(const int& processID)
+{
+    return processID & RECYCLED_PROCESS_BIT ? processID & (MAX_RECYCLED_PROCESS_SLOTS - 1) : processID;
+}
+
+/*
+    @param  A const Lvalue reference to a process ID.
+    @return How many times the slot of the process was recycled before the process got it.
+*/
+inline int getProcessGeneration(const int& processID)
+{
+    return processID & RECYCLED_PROCESS_BIT ? ((processID >> PROCESS_SLOT_BITS) & (MAX_PROCESS_GENERATION - 1)) + 1 : 0;
+}
+
+/*
+    @param  A const Lvalue reference to a process table slot, below MAX_RECYCLED_PROCESS_SLOTS unless the generation is 0.
+    @param  A const Lvalue reference to the generation of the slot, at most MAX_PROCESS_GENERATION.
+    @return The process ID made of the slot and the generation.
+*/
+inline int makeProcessID(const int& slot, const int& generation)
+{
+    return generation == 0 ? slot : RECYCLED_PROCESS_BIT | ((generation - 1) << PROCESS_SLOT_BITS) | slot;
+}
+
+constexpr unsigned int INLINE_CHILD_CAPACITY{6};   //Children a Process records without allocating
+
+//Read-only view of a contiguous run of PIDs
+struct ProcessIDSpan
+{
+    const int* first{nullptr};
+    const int* last{nullptr};
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    unsigned int size() const { return static_cast<unsigned int>(last - first); }
+    bool empty() const { return first == last; }
+    const int& operator[](const unsigned int& index) const { return first[index]; }
+};
+
 enum Type
 {
     REGULAR,    //Indicates that the process has no parent and no children
@@ -41,7 +94,7 @@ public:
     int getProcessID() const;
     int getProcessState() const;
     Type getProcessType() const;
-    std::vector<int> getChildProcesses() const;
+    ProcessIDSpan getChildProcesses() const;
     int getParentProcessID() const;
 
     //Utilities
@@ -54,8 +107,13 @@ private:
     int processID_;
     int processState_;
     Type processType_;
-    std::vector<int> childProcesses_;   //contains the PIDs of the process's children
     int parentProcessID_;
+
+    //The PIDs of the process's children, oldest first.
+    //They live in the inline buffer until there are more than INLINE_CHILD_CAPACITY of them, and in spilledChildren_ from then until there are none left.
+    int inlineChildren_[INLINE_CHILD_CAPACITY];
+    unsigned int inlineChildCount_;
+    std::vector<int> spilledChildren_;
 };
 
 // It is ok for a process to run without having any pages in this simulation
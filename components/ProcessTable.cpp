@@ -0,0 +1,663 @@
+// Alan Tuecci
+#include "ProcessTable.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   The table holds only the operating system placeholder (PID 0, state 'NO_PROCESS') in slot 0.
+            Recycling is off.
+*/
+ProcessTable::ProcessTable():
+    processIDs_(1, NO_PROCESS),
+    status_(1, static_cast<std::uint8_t>(NO_PROCESS)),
+    parents_(1, NO_PROCESS),
+    firstChildren_(1, 0),
+    lastChildren_(1, 0),
+    lastZombieChildren_(1, 0),
+    nextSiblings_(1, 0),
+    previousSiblings_(1, 0),
+    owners_(1, NO_PROCESS),
+    firstThreads_(1, 0),
+    freeSlots_{},
+    processCount_{0},
+    recycling_{false}
+{
+}
+
+//--------------------------------------------Setters--------------------------------------------
+
+/*
+    @param  True to recycle the slots of released processes, false to give every new process a fresh slot.
+    @post   Slots released from now on are recycled or not accordingly. Slots released earlier stay recyclable.
+*/
+void ProcessTable::setRecycling(const bool& recycling)
+{
+    recycling_ = recycling;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @param  A const Lvalue reference to the new process state.
+    @post   The state of the process is updated.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+void ProcessTable::setProcessState(const int& processID, const int& processState)
+{
+    int slot = findSlot(processID);
+    status_[slot] = (status_[slot] & ~STATE_MASK) | (static_cast<std::uint8_t>(processState) & STATE_MASK);
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @param  A const Lvalue reference to the new process type.
+    @post   The type of the process is updated.
+            A child that becomes a zombie joins the end of its parent's zombie children.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+void ProcessTable::setProcessType(const int& processID, const Type& processType)
+{
+    int slot = findSlot(processID);
+    bool becomesZombie = processType == ZOMBIE && ((status_[slot] & TYPE_MASK) >> TYPE_SHIFT) != ZOMBIE;
+    status_[slot] = (status_[slot] & ~TYPE_MASK) | ((static_cast<std::uint8_t>(processType) << TYPE_SHIFT) & TYPE_MASK);
+    if (becomesZombie)
+        moveToZombieChildren(slot);
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @param  True if the process is now blocked waiting for a child, false if it stopped waiting.
+    @post   The waiting flag of the process is updated.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+void ProcessTable::setWaitingForChild(const int& processID, const bool& waiting)
+{
+    int slot = findSlot(processID);
+    if (waiting)
+        status_[slot] |= WAITING_FOR_CHILD;
+    else
+        status_[slot] &= ~WAITING_FOR_CHILD;
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @return True if released slots are recycled, false otherwise.
+*/
+bool ProcessTable::isRecycling() const
+{
+    return recycling_;
+}
+
+/*
+    @param  A const Lvalue reference to a process ID.
+    @return True if the process is in the table, false if it was never created or was released.
+*/
+bool ProcessTable::contains(const int& processID) const
+{
+    if (processID < 0)
+        return false;
+    std::size_t slot = static_cast<std::size_t>(getProcessSlot(processID));
+    return slot < processIDs_.size() && processIDs_[slot] == processID && !(status_[slot] & FREE_SLOT);
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The process state.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getProcessState(const int& processID) const
+{
+    return status_[findSlot(processID)] & STATE_MASK;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The process Type.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+Type ProcessTable::getProcessType(const int& processID) const
+{
+    return static_cast<Type>((status_[findSlot(processID)] & TYPE_MASK) >> TYPE_SHIFT);
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The process's parent's process ID, NO_PROCESS if it has none.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getParentProcessID(const int& processID) const
+{
+    return parents_[findSlot(processID)];
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return True if the process has at least one child in the table.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+bool ProcessTable::hasChildren(const int& processID) const
+{
+    return firstChildren_[findSlot(processID)] != 0;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The PID of the oldest child of the process in the table, NO_PROCESS if it has none.
+            Together with getNextSibling() this walks the children without copying them.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getFirstChild(const int& processID) const
+{
+    int child = firstChildren_[findSlot(processID)];
+    return child != 0 ? processIDs_[child] : NO_PROCESS;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The PID of the next younger child of the same parent, NO_PROCESS if there is none.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getNextSibling(const int& processID) const
+{
+    int sibling = nextSiblings_[findSlot(processID)];
+    return sibling != 0 ? processIDs_[sibling] : NO_PROCESS;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The PID reached by following oldest children down from the process, the process itself if it has no children.
+            It is the first process of the subtree visited in post-order (children before their parent).
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getFirstLeaf(const int& processID) const
+{
+    int slot = findSlot(processID);
+    while (firstChildren_[slot] != 0)
+        slot = firstChildren_[slot];
+    return processIDs_[slot];
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The PIDs of the children of the process in the table, oldest first.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+std::vector<int> ProcessTable::getChildProcesses(const int& processID) const
+{
+    std::vector<int> childProcesses;
+    for (int child = firstChildren_[findSlot(processID)]; child != 0; child = nextSiblings_[child])
+        childProcesses.push_back(processIDs_[child]);
+    return childProcesses;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The PID of the zombie child of the process that exited first, NO_PROCESS if it has no zombie children.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getFirstZombieChild(const int& processID) const
+{
+    int slot = findSlot(processID);
+    return lastZombieChildren_[slot] != 0 ? processIDs_[firstChildren_[slot]] : NO_PROCESS;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return True if the process is blocked waiting for a child, false otherwise.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+bool ProcessTable::isWaitingForChild(const int& processID) const
+{
+    return status_[findSlot(processID)] & WAITING_FOR_CHILD;
+}
+
+/*
+    @param  A const Lvalue reference to the ID of a process or a thread.
+    @return True if the ID belongs to a thread, false if it belongs to a process.
+
+    @note   If the ID is not in the table, throw std::out_of_range exception.
+*/
+bool ProcessTable::isThread(const int& processID) const
+{
+    return owners_[findSlot(processID)] != NO_PROCESS;
+}
+
+/*
+    @param  A const Lvalue reference to the ID of a process or a thread.
+    @return The PID of the process whose address space it runs in: the owner of a thread, or the process itself.
+
+    @note   If the ID is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getOwnerProcessID(const int& processID) const
+{
+    int owner = owners_[findSlot(processID)];
+    return owner != NO_PROCESS ? owner : processID;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The ID of the youngest thread of the process, NO_PROCESS if it has none.
+            Together with getNextThread() this walks the threads without copying them.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getFirstThread(const int& processID) const
+{
+    int thread = firstThreads_[findSlot(processID)];
+    return thread != 0 ? processIDs_[thread] : NO_PROCESS;
+}
+
+/*
+    @param  A const Lvalue reference to the thread ID.
+    @return The ID of the next older thread of the same process, NO_PROCESS if there is none.
+
+    @note   If the thread is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::getNextThread(const int& threadID) const
+{
+    int thread = nextSiblings_[findSlot(threadID)];
+    return thread != 0 ? processIDs_[thread] : NO_PROCESS;
+}
+
+/*
+    @param  A const Lvalue reference to the process ID.
+    @return The IDs of the threads of the process in the table, oldest first.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+std::vector<int> ProcessTable::getThreads(const int& processID) const
+{
+    std::vector<int> threads;
+    for (int thread = firstThreads_[findSlot(processID)]; thread != 0; thread = nextSiblings_[thread])
+        threads.push_back(processIDs_[thread]);
+    std::reverse(threads.begin(), threads.end());
+    return threads;
+}
+
+/*
+    @return The PID the next call to create() hands out.
+
+    @note   If the table is full, throw std::length_error exception.
+*/
+int ProcessTable::peekNextProcessID() const
+{
+    int slot = nextFreeSlot();
+    if (static_cast<std::size_t>(slot) == processIDs_.size())
+        return makeProcessID(slot, 0);
+    return makeProcessID(slot, getProcessGeneration(processIDs_[slot]) + 1);
+}
+
+/*
+    @return The number of processes in the table, not counting the operating system placeholder.
+*/
+unsigned long long ProcessTable::getProcessCount() const
+{
+    return processCount_;
+}
+
+/*
+    @return The number of slots the table holds, used or free, including the operating system placeholder.
+*/
+unsigned long long ProcessTable::getSlotCount() const
+{
+    return processIDs_.size();
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  A const Lvalue reference to the state of the new process.
+    @param  A const Lvalue reference to the type of the new process.
+    @param  A const Lvalue reference to the PID of the parent, NO_PROCESS if the process has none.
+    @post   The process is added to the table, and becomes the youngest child of its parent.
+    @return The PID of the new process.
+
+    @note   If the parent is not in the table, throw std::out_of_range exception.
+    @note   If the table is full, throw std::length_error exception.
+*/
+int ProcessTable::create(const int& processState, const Type& processType, const int& parentProcessID)
+{
+    int parentSlot = parentProcessID != NO_PROCESS ? findSlot(parentProcessID) : 0;
+    int processID = peekNextProcessID();
+    int slot = getProcessSlot(processID);
+    if (static_cast<std::size_t>(slot) == processIDs_.size())
+    {
+        processIDs_.push_back(processID);
+        status_.push_back(0);
+        parents_.push_back(NO_PROCESS);
+        firstChildren_.push_back(0);
+        lastChildren_.push_back(0);
+        lastZombieChildren_.push_back(0);
+        nextSiblings_.push_back(0);
+        previousSiblings_.push_back(0);
+        owners_.push_back(NO_PROCESS);
+        firstThreads_.push_back(0);
+    }
+    else
+    {
+        freeSlots_.pop_back();
+        processIDs_[slot] = processID;
+        firstChildren_[slot] = 0;
+        lastChildren_[slot] = 0;
+        lastZombieChildren_[slot] = 0;
+        owners_[slot] = NO_PROCESS;
+        firstThreads_[slot] = 0;
+    }
+
+    status_[slot] = packStatus(processState, processType);
+    parents_[slot] = parentProcessID;
+    nextSiblings_[slot] = 0;
+    previousSiblings_[slot] = 0;
+    if (parentSlot != 0)
+    {
+        previousSiblings_[slot] = lastChildren_[parentSlot];
+        if (lastChildren_[parentSlot] != 0)
+            nextSiblings_[lastChildren_[parentSlot]] = slot;
+        else
+            firstChildren_[parentSlot] = slot;
+        lastChildren_[parentSlot] = slot;
+    }
+    processCount_++;
+    return processID;
+}
+
+/*
+    @param  A const Lvalue reference to the number of processes to create.
+    @param  A const Lvalue reference to the state of the new processes.
+    @param  A const Lvalue reference to the type of the new processes.
+    @param  A const Lvalue reference to the PID of their parent, NO_PROCESS if they have none.
+    @post   The processes are added to the table in fresh slots at its end, and become the youngest children of their parent in PID order.
+            Every column grows once, and recycled slots are left for later calls to create() so that the range stays contiguous.
+    @return The PID of the first new process; the others follow it one by one. NO_PROCESS if the count is 0.
+
+    @note   If the parent is not in the table, throw std::out_of_range exception.
+    @note   If the table can't fit the processes, throw std::length_error exception.
+*/
+int ProcessTable::createRange(const unsigned int& count, const int& processState, const Type& processType, const int& parentProcessID)
+{
+    if (count == 0)
+        return NO_PROCESS;
+    int parentSlot = parentProcessID != NO_PROCESS ? findSlot(parentProcessID) : 0;
+    if (processIDs_.size() + count > MAX_PROCESS_SLOTS)
+        throw std::length_error("The process table is full");
+
+    int firstSlot = static_cast<int>(processIDs_.size());
+    int lastSlot = firstSlot + count - 1;
+    for (int slot = firstSlot; slot <= lastSlot; slot++)
+        processIDs_.push_back(makeProcessID(slot, 0));
+    status_.resize(lastSlot + 1, packStatus(processState, processType));
+    parents_.resize(lastSlot + 1, parentProcessID);
+    firstChildren_.resize(lastSlot + 1, 0);
+    lastChildren_.resize(lastSlot + 1, 0);
+    lastZombieChildren_.resize(lastSlot + 1, 0);
+    nextSiblings_.resize(lastSlot + 1, 0);
+    previousSiblings_.resize(lastSlot + 1, 0);
+    owners_.resize(lastSlot + 1, NO_PROCESS);
+    firstThreads_.resize(lastSlot + 1, 0);
+
+    if (parentSlot != 0)
+    {
+        for (int slot = firstSlot; slot <= lastSlot; slot++)
+        {
+            previousSiblings_[slot] = slot - 1;
+            nextSiblings_[slot] = slot < lastSlot ? slot + 1 : 0;
+        }
+        previousSiblings_[firstSlot] = lastChildren_[parentSlot];
+        if (lastChildren_[parentSlot] != 0)
+            nextSiblings_[lastChildren_[parentSlot]] = firstSlot;
+        else
+            firstChildren_[parentSlot] = firstSlot;
+        lastChildren_[parentSlot] = lastSlot;
+    }
+    processCount_ += count;
+    return makeProcessID(firstSlot, 0);
+}
+
+/*
+    @param  A const Lvalue reference to the PID of the process the thread belongs to.
+    @param  A const Lvalue reference to the state of the new thread.
+    @post   The thread is added to the table and becomes the youngest thread of the process.
+            It gets an ID from the same sequence as PIDs, and has no parent or children.
+    @return The ID of the new thread.
+
+    @note   If the process is not in the table or is itself a thread, throw std::out_of_range exception.
+    @note   If the table is full, throw std::length_error exception.
+*/
+int ProcessTable::createThread(const int& ownerProcessID, const int& threadState)
+{
+    int ownerSlot = findSlot(ownerProcessID);
+    if (ownerSlot == 0 || owners_[ownerSlot] != NO_PROCESS)
+        throw std::out_of_range("Threads can only belong to a process");
+
+    int threadID = create(threadState);
+    int slot = getProcessSlot(threadID);
+    owners_[slot] = ownerProcessID;
+    nextSiblings_[slot] = firstThreads_[ownerSlot];
+    if (firstThreads_[ownerSlot] != 0)
+        previousSiblings_[firstThreads_[ownerSlot]] = slot;
+    firstThreads_[ownerSlot] = slot;
+    return threadID;
+}
+
+/*
+    @param  A const Lvalue reference to the PID of a process that no longer needs its entry.
+    @post   The process leaves the table and its parent's children. Its own children, if any are left, no longer have a parent.
+            A thread leaves its owner's threads. Threads of a released process, if any are left, no longer have an owner.
+            If recycling is on, the slot can be handed out again under the next generation, unless the generation would wrap around
+            or the slot is past the first MAX_RECYCLED_PROCESS_SLOTS.
+
+    @note   If the process is not in the table, or is the operating system placeholder, throw std::out_of_range exception.
+*/
+void ProcessTable::release(const int& processID)
+{
+    int slot = findSlot(processID);
+    if (slot == 0)
+        throw std::out_of_range("The operating system placeholder can not be released");
+
+    unlinkFromParent(slot);
+    unlinkFromOwner(slot);
+    for (int thread = firstThreads_[slot]; thread != 0; )
+    {
+        int nextThread = nextSiblings_[thread];
+        owners_[thread] = NO_PROCESS;
+        nextSiblings_[thread] = 0;
+        previousSiblings_[thread] = 0;
+        thread = nextThread;
+    }
+    firstThreads_[slot] = 0;
+    for (int child = firstChildren_[slot]; child != 0; )
+    {
+        int nextChild = nextSiblings_[child];
+        parents_[child] = NO_PROCESS;
+        nextSiblings_[child] = 0;
+        previousSiblings_[child] = 0;
+        child = nextChild;
+    }
+    firstChildren_[slot] = 0;
+    lastChildren_[slot] = 0;
+    lastZombieChildren_[slot] = 0;
+
+    status_[slot] = FREE_SLOT | static_cast<std::uint8_t>(TERMINATED);
+    processCount_--;
+    if (recycling_ && slot < MAX_RECYCLED_PROCESS_SLOTS && getProcessGeneration(processID) < MAX_PROCESS_GENERATION)
+        freeSlots_.push_back(slot);
+}
+
+/*
+    @param  A const Lvalue reference to a process state.
+    @param  A const Lvalue reference to a process type.
+    @return The status byte of a live process with the state and type.
+*/
+std::uint8_t ProcessTable::packStatus(const int& processState, const Type& processType)
+{
+    return (static_cast<std::uint8_t>(processState) & STATE_MASK) | ((static_cast<std::uint8_t>(processType) << TYPE_SHIFT) & TYPE_MASK);
+}
+
+/*
+    @param  A const Lvalue reference to a process ID.
+    @return The slot of the process.
+
+    @note   If the process is not in the table, throw std::out_of_range exception.
+*/
+int ProcessTable::findSlot(const int& processID) const
+{
+    if (!contains(processID))
+        throw std::out_of_range("The process with the requested PID does not exist");
+    return getProcessSlot(processID);
+}
+
+/*
+    @return The slot the next process goes into: the most recently released recyclable slot, or a new slot at the end of the table.
+
+    @note   If the table is full, throw std::length_error exception.
+*/
+int ProcessTable::nextFreeSlot() const
+{
+    if (!freeSlots_.empty())
+        return freeSlots_.back();
+    if (processIDs_.size() >= MAX_PROCESS_SLOTS)
+        throw std::length_error("The process table is full");
+    return static_cast<int>(processIDs_.size());
+}
+
+/*
+    @param  A const Lvalue reference to a slot.
+    @post   The process in the slot is taken out of its parent's list of children.
+*/
+void ProcessTable::unlinkFromParent(const int& slot)
+{
+    if (parents_[slot] == NO_PROCESS || !contains(parents_[slot]))
+        return;
+
+    int parentSlot = getProcessSlot(parents_[slot]);
+    if (lastZombieChildren_[parentSlot] == slot)
+        lastZombieChildren_[parentSlot] = previousSiblings_[slot];  //Zombies come first, so the zombie before it, if any, is now the last one
+    if (previousSiblings_[slot] != 0)
+        nextSiblings_[previousSiblings_[slot]] = nextSiblings_[slot];
+    else
+        firstChildren_[parentSlot] = nextSiblings_[slot];
+    if (nextSiblings_[slot] != 0)
+        previousSiblings_[nextSiblings_[slot]] = previousSiblings_[slot];
+    else
+        lastChildren_[parentSlot] = previousSiblings_[slot];
+
+    parents_[slot] = NO_PROCESS;
+    nextSiblings_[slot] = 0;
+    previousSiblings_[slot] = 0;
+}
+
+/*
+    @param  A const Lvalue reference to the slot of a process that just became a zombie.
+    @post   The process moves right behind its parent's last zombie child, or to the front of the children if it is the first zombie.
+*/
+void ProcessTable::moveToZombieChildren(const int& slot)
+{
+    int parentProcessID = parents_[slot];
+    if (parentProcessID == NO_PROCESS || !contains(parentProcessID))
+        return;
+
+    unlinkFromParent(slot);
+    parents_[slot] = parentProcessID;
+    int parentSlot = getProcessSlot(parentProcessID);
+    int previous = lastZombieChildren_[parentSlot];
+    int next = previous != 0 ? nextSiblings_[previous] : firstChildren_[parentSlot];
+
+    previousSiblings_[slot] = previous;
+    nextSiblings_[slot] = next;
+    if (previous != 0)
+        nextSiblings_[previous] = slot;
+    else
+        firstChildren_[parentSlot] = slot;
+    if (next != 0)
+        previousSiblings_[next] = slot;
+    else
+        lastChildren_[parentSlot] = slot;
+    lastZombieChildren_[parentSlot] = slot;
+}
+
+/*
+    @param  A const Lvalue reference to a slot.
+    @post   The thread in the slot is taken out of its owner's list of threads. Nothing changes for a process.
+*/
+void ProcessTable::unlinkFromOwner(const int& slot)
+{
+    if (owners_[slot] == NO_PROCESS || !contains(owners_[slot]))
+        return;
+
+    int ownerSlot = getProcessSlot(owners_[slot]);
+    if (previousSiblings_[slot] != 0)
+        nextSiblings_[previousSiblings_[slot]] = nextSiblings_[slot];
+    else
+        firstThreads_[ownerSlot] = nextSiblings_[slot];
+    if (nextSiblings_[slot] != 0)
+        previousSiblings_[nextSiblings_[slot]] = previousSiblings_[slot];
+
+    owners_[slot] = NO_PROCESS;
+    nextSiblings_[slot] = 0;
+    previousSiblings_[slot] = 0;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   Every column of the table, the free slots, the process count and the recycling setting are appended to the checkpoint.
+*/
+void ProcessTable::writeCheckpoint(CheckpointWriter& writer) const
+{
+    processIDs_.writeCheckpoint(writer);
+    status_.writeCheckpoint(writer);
+    parents_.writeCheckpoint(writer);
+    firstChildren_.writeCheckpoint(writer);
+    lastChildren_.writeCheckpoint(writer);
+    lastZombieChildren_.writeCheckpoint(writer);
+    nextSiblings_.writeCheckpoint(writer);
+    previousSiblings_.writeCheckpoint(writer);
+    owners_.writeCheckpoint(writer);
+    firstThreads_.writeCheckpoint(writer);
+    freeSlots_.writeCheckpoint(writer);
+    writer.write(processCount_);
+    writer.write(recycling_);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The table holds the processes it held when the checkpoint was written, with the same PIDs and relationships.
+
+    @note   If the columns have different lengths or the OS placeholder slot is missing, throw std::runtime_error exception.
+*/
+void ProcessTable::readCheckpoint(CheckpointReader& reader)
+{
+    processIDs_.readCheckpoint(reader);
+    status_.readCheckpoint(reader);
+    parents_.readCheckpoint(reader);
+    firstChildren_.readCheckpoint(reader);
+    lastChildren_.readCheckpoint(reader);
+    lastZombieChildren_.readCheckpoint(reader);
+    nextSiblings_.readCheckpoint(reader);
+    previousSiblings_.readCheckpoint(reader);
+    owners_.readCheckpoint(reader);
+    firstThreads_.readCheckpoint(reader);
+    freeSlots_.readCheckpoint(reader);
+    processCount_ = reader.read<unsigned long long>();
+    recycling_ = reader.read<bool>();
+
+    const std::size_t slotCount = processIDs_.size();
+    if (slotCount == 0 || status_.size() != slotCount || parents_.size() != slotCount || firstChildren_.size() != slotCount
+        || lastChildren_.size() != slotCount || lastZombieChildren_.size() != slotCount || nextSiblings_.size() != slotCount
+        || previousSiblings_.size() != slotCount || owners_.size() != slotCount || firstThreads_.size() != slotCount)
+        throw std::runtime_error("The checkpoint has a corrupt process table");
+}
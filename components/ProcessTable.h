@@ -0,0 +1,99 @@
+// Alan Tuecci
+#ifndef PROCESSTABLE_H
+#define PROCESSTABLE_H
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include "Process.h"
+#include "Checkpoint.h"
+#include "CopyOnWrite.h"
+
+/*
+    Table of every process in the system, stored as one array per field instead of one Process object per entry.
+    A state and a type are packed together into one byte, and children are kept as an intrusive list of sibling links between slots,
+    so an entry costs a few words and no heap allocation of its own.
+    Zombie children are kept at the front of their parent's list, in the order they exited, so reaping one takes constant time.
+    Slot 0 holds the placeholder for the operating system (PID 0) and is never released.
+
+    Released slots can be recycled. A recycled slot gets the next generation, so its new PID is different from every PID it had before;
+    a slot whose generation would wrap around, or past the first MAX_RECYCLED_PROCESS_SLOTS, is retired instead. Recycling is off by default,
+    which keeps PIDs sequential up to MAX_PROCESS_SLOTS - 1.
+
+    Threads are entries too, with an owner instead of a parent. A thread has no parent or children of its own,
+    so its sibling links are free to chain it into its owner's list of threads.
+
+    The columns are chunked vectors, so a copy of the table shares every chunk until it changes an entry in it.
+*/
+class ProcessTable
+{
+public:
+    //Constructors
+    ProcessTable();
+
+    //Setters
+    void setRecycling(const bool& recycling);
+    void setProcessState(const int& processID, const int& processState);
+    void setProcessType(const int& processID, const Type& processType);
+    void setWaitingForChild(const int& processID, const bool& waiting);
+
+    //Getters
+    bool isRecycling() const;
+    bool contains(const int& processID) const;
+    int getProcessState(const int& processID) const;
+    Type getProcessType(const int& processID) const;
+    int getParentProcessID(const int& processID) const;
+    bool hasChildren(const int& processID) const;
+    int getFirstChild(const int& processID) const;
+    int getNextSibling(const int& processID) const;
+    int getFirstLeaf(const int& processID) const;
+    std::vector<int> getChildProcesses(const int& processID) const;
+    int getFirstZombieChild(const int& processID) const;
+    bool isWaitingForChild(const int& processID) const;
+    bool isThread(const int& processID) const;
+    int getOwnerProcessID(const int& processID) const;
+    int getFirstThread(const int& processID) const;
+    int getNextThread(const int& threadID) const;
+    std::vector<int> getThreads(const int& processID) const;
+    int peekNextProcessID() const;
+    unsigned long long getProcessCount() const;
+    unsigned long long getSlotCount() const;
+
+    //Utilities
+    int create(const int& processState, const Type& processType = REGULAR, const int& parentProcessID = NO_PROCESS);
+    int createRange(const unsigned int& count, const int& processState, const Type& processType = REGULAR, const int& parentProcessID = NO_PROCESS);
+    int createThread(const int& ownerProcessID, const int& threadState);
+    void release(const int& processID);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    static constexpr std::uint8_t STATE_MASK{0x07};     //Bits 0-2 hold the process state
+    static constexpr std::uint8_t TYPE_SHIFT{3};        //Bits 3-4 hold the process type
+    static constexpr std::uint8_t TYPE_MASK{0x18};
+    static constexpr std::uint8_t WAITING_FOR_CHILD{0x20};  //Set while the process is blocked in SimWait()
+    static constexpr std::uint8_t FREE_SLOT{0x80};      //Set while the slot holds no process
+
+    static std::uint8_t packStatus(const int& processState, const Type& processType);
+    int findSlot(const int& processID) const;
+    int nextFreeSlot() const;
+    void unlinkFromParent(const int& slot);
+    void moveToZombieChildren(const int& slot);
+    void unlinkFromOwner(const int& slot);
+
+    ChunkedVector<int> processIDs_;          //PID of the process in each slot; a free slot keeps the PID it last had
+    ChunkedVector<std::uint8_t> status_;     //Packed state, type and free flag
+    ChunkedVector<int> parents_;             //PID of the parent, NO_PROCESS if none
+    ChunkedVector<int> firstChildren_;       //Slot of the oldest live child, 0 if none
+    ChunkedVector<int> lastChildren_;        //Slot of the youngest live child, 0 if none
+    ChunkedVector<int> lastZombieChildren_;  //Slot of the zombie child that exited last, 0 if none; zombies come first among the children
+    ChunkedVector<int> nextSiblings_;        //Slot of the next younger sibling, 0 if none
+    ChunkedVector<int> previousSiblings_;    //Slot of the next older sibling, 0 if none
+    ChunkedVector<int> owners_;              //PID of the process a thread belongs to, NO_PROCESS for a process
+    ChunkedVector<int> firstThreads_;        //Slot of the youngest thread of a process, 0 if none; threads are linked through their sibling columns
+    ChunkedVector<int> freeSlots_;           //Released slots waiting to be recycled, most recent last
+    unsigned long long processCount_;
+    bool recycling_;
+};
+#endif
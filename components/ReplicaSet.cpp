@@ -0,0 +1,86 @@
+// Alan Tuecci
+#include "ReplicaSet.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   Replica set object initialized with static placement and no disks.
+*/
+ReplicaSet::ReplicaSet() : ReplicaSet(STATIC_PLACEMENT, std::vector<int>{})
+{
+}
+
+/*
+    @param  A const lvalue reference to the placement mode, STATIC_PLACEMENT, SHORTEST_QUEUE or EARLIEST_COMPLETION.
+    @param  A const lvalue reference to the numbers of the distinct disks holding the copies. The caller checks the mode and the disks.
+    @post   A replica set that hasn't placed any read.
+*/
+ReplicaSet::ReplicaSet(const int& placement, const std::vector<int>& disks) :
+    placement_{placement},
+    disks_{disks},
+    readsPerDisk_(disks.size(), 0),
+    reads_{0},
+    queueImbalance_{}
+{
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @return The numbers of the disks in the set.
+*/
+const std::vector<int>& ReplicaSet::getDisks() const
+{
+    return disks_;
+}
+
+/*
+    @return The reads placed, how evenly they were spread, and the distribution of the queue imbalance when they were placed.
+            The response times come from the disks, so the caller fills them in.
+*/
+ReplicaSetStats ReplicaSet::getStats() const
+{
+    ReplicaSetStats stats;
+    stats.placement = placement_;
+    stats.disks = static_cast<unsigned int>(disks_.size());
+    stats.reads = reads_;
+    if (!readsPerDisk_.empty())
+    {
+        stats.busiestDiskReads = *std::max_element(readsPerDisk_.begin(), readsPerDisk_.end());
+        stats.quietestDiskReads = *std::min_element(readsPerDisk_.begin(), readsPerDisk_.end());
+    }
+    stats.queueImbalance = queueImbalance_.getSummary();
+    return stats;
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The placement mode, the disks, the reads placed on each and the imbalance statistics are appended to the checkpoint.
+*/
+void ReplicaSet::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(placement_);
+    writer.writeArray(disks_);
+    writer.writeArray(readsPerDisk_);
+    writer.write(reads_);
+    queueImbalance_.writeCheckpoint(writer);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The replica set is in the state it was in when the checkpoint was written.
+
+    @note   If the reads per disk don't match the disks, throw std::runtime_error exception.
+*/
+void ReplicaSet::readCheckpoint(CheckpointReader& reader)
+{
+    placement_ = reader.read<int>();
+    reader.readArray(disks_);
+    reader.readArray(readsPerDisk_);
+    if (disks_.size() != readsPerDisk_.size())
+        throw std::runtime_error("The checkpoint has a corrupt replica set");
+    reads_ = reader.read<unsigned long long>();
+    queueImbalance_.readCheckpoint(reader);
+}
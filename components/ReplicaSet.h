@@ -0,0 +1,92 @@
+// Alan Tuecci
+#ifndef REPLICASET_H
+#define REPLICASET_H
+#include <vector>
+#include <algorithm>
+#include "DiskManager.h"
+#include "Histogram.h"
+#include "Checkpoint.h"
+
+constexpr int STATIC_PLACEMENT{0};      //A process always reads from the same replica, chosen by its PID
+constexpr int SHORTEST_QUEUE{1};        //A read goes to the replica with the fewest requests at its disk
+constexpr int EARLIEST_COMPLETION{2};   //A read goes to the replica expected to finish it first, given its queue, slots and service times
+
+struct ReplicaSetStats
+{
+    int placement{STATIC_PLACEMENT};
+    unsigned int disks{0};
+    unsigned long long reads{0};
+    unsigned long long busiestDiskReads{0};     //Reads placed on the disk that got the most
+    unsigned long long quietestDiskReads{0};    //Reads placed on the disk that got the fewest
+    PercentileSummary queueImbalance;           //Requests at the busiest disk of the set minus those at the quietest one, when a read was placed
+    PercentileSummary responseTime;             //Response times of all the requests the disks of the set started, reads of the set or not
+};
+
+/*
+    Disks that hold copies of the same data. A read names the set instead of a disk, and the placement mode picks the disk,
+    from the load the disks track as requests arrive and finish.
+*/
+class ReplicaSet
+{
+public:
+    //Constructors
+    ReplicaSet();
+    ReplicaSet(const int& placement, const std::vector<int>& disks);
+
+    //Getters
+    const std::vector<int>& getDisks() const;
+    ReplicaSetStats getStats() const;
+
+    //Utilities
+    template <class LoadOf>
+    int place(const int& PID, const LoadOf& loadOf);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    int placement_;
+    std::vector<int> disks_;
+    std::vector<unsigned long long> readsPerDisk_;  //Indexed like disks_
+
+    unsigned long long reads_;
+    Histogram queueImbalance_;
+};
+
+/*
+    @param  A const lvalue reference to the PID of the reading process.
+    @param  A const lvalue reference to a function that takes a disk number and returns the DiskLoad of the disk.
+    @post   The read and the imbalance of the disks' queues are recorded.
+    @return The number of the disk the read goes to. Ties go to the fewest requests, then to the disk listed first.
+*/
+template <class LoadOf>
+int ReplicaSet::place(const int& PID, const LoadOf& loadOf)
+{
+    std::size_t chosen{0};
+    unsigned long long fewestRequests{~0ull};
+    unsigned long long mostRequests{0};
+    DiskLoad best;
+    for (std::size_t replica = 0; replica < disks_.size(); replica++)
+    {
+        DiskLoad load = loadOf(disks_[replica]);
+        fewestRequests = std::min(fewestRequests, load.queueDepth);
+        mostRequests = std::max(mostRequests, load.queueDepth);
+        bool better = replica == 0
+            || (placement_ == EARLIEST_COMPLETION && load.expectedCompletionTime != best.expectedCompletionTime
+                ? load.expectedCompletionTime < best.expectedCompletionTime
+                : load.queueDepth < best.queueDepth);
+        if (placement_ != STATIC_PLACEMENT && better)
+        {
+            chosen = replica;
+            best = load;
+        }
+    }
+    if (placement_ == STATIC_PLACEMENT)
+        chosen = static_cast<std::size_t>(getProcessSlot(PID)) % disks_.size();
+
+    reads_++;
+    readsPerDisk_[chosen]++;
+    queueImbalance_.record(mostRequests - fewestRequests);
+    return disks_[chosen];
+}
+#endif
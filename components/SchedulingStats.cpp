@@ -0,0 +1,309 @@
+// Alan Tuecci
+#include "SchedulingStats.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   No process records exist and every histogram is empty.
+*/
+SchedulingStats::SchedulingStats():
+    records_{},
+    arrivedProcesses_{0},
+    completedProcesses_{0},
+    totalContextSwitches_{0}
+{
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @return True if the arrival of the process was recorded, false otherwise.
+*/
+bool SchedulingStats::hasProcess(const int& processID) const
+{
+    unsigned long long slot = getProcessSlot(processID);
+    return processID > 0 && slot < records_.size() && records_[slot].arrived && records_[slot].processID == processID;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @param  The current simulated time, used for the time spent in the current state of a live process.
+    @return The metrics recorded for the process.
+
+    @note   If the process was never recorded, throw std::out_of_range exception.
+*/
+ProcessMetrics SchedulingStats::getProcessMetrics(const int& processID, const unsigned long long& now) const
+{
+    if (!hasProcess(processID))
+        throw std::out_of_range("No scheduling metrics were recorded for the requested process");
+
+    const Record& record = records_[getProcessSlot(processID)];
+    ProcessMetrics metrics = record.metrics;
+    if (record.blocked)
+    {
+        if (record.blockedOnDiskIO)
+            metrics.ioWaitTime += now - record.blockedSince;
+        else
+            metrics.childWaitTime += now - record.blockedSince;
+    }
+    metrics.readyWaitTime = readyWaitTime(record, now);
+    return metrics;
+}
+
+/*
+    @return Process counts and the p50/p95/p99 distributions of turnaround, waiting and response time and context switches.
+*/
+SchedulingSummary SchedulingStats::getSummary() const
+{
+    SchedulingSummary summary;
+    summary.arrivedProcesses = arrivedProcesses_;
+    summary.completedProcesses = completedProcesses_;
+    summary.totalContextSwitches = totalContextSwitches_;
+    summary.turnaroundTime = turnaroundTime_.getSummary();
+    summary.waitingTime = waitingTime_.getSummary();
+    summary.responseTime = responseTime_.getSummary();
+    summary.contextSwitches = contextSwitches_.getSummary();
+    return summary;
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @param  The current simulated time.
+    @post   A fresh record is started for the process with the current time as its arrival time.
+            It replaces the record of the process that had the same process table slot before.
+*/
+void SchedulingStats::recordArrival(const int& processID, const unsigned long long& now)
+{
+    if (processID <= 0)
+        return;
+    unsigned long long slot = getProcessSlot(processID);
+    if (slot >= records_.size())
+        records_.resize(slot + 1);
+
+    records_[slot] = Record{};
+    records_[slot].processID = processID;
+    records_[slot].arrived = true;
+    records_[slot].metrics.arrivalTime = now;
+    arrivedProcesses_++;
+}
+
+/*
+    @param  A const lvalue reference to the first of a run of consecutive process IDs.
+    @param  The number of processes in the run.
+    @param  The current simulated time.
+    @post   Same as recording the arrival of each process, with the records grown once for the whole run.
+*/
+void SchedulingStats::recordArrivals(const int& firstProcessID, const unsigned int& count, const unsigned long long& now)
+{
+    if (count == 0 || firstProcessID <= 0)
+        return;
+    std::size_t reusedSlots = records_.size();
+    std::size_t lastSlot = static_cast<std::size_t>(getProcessSlot(firstProcessID + count - 1));
+    if (lastSlot >= records_.size())
+        records_.resize(lastSlot + 1);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        std::size_t slot = static_cast<std::size_t>(getProcessSlot(firstProcessID + i));
+        Record& record = records_[slot];
+        if (slot < reusedSlots)
+            record = Record{};      //Slots added by the resize are already fresh
+        record.processID = firstProcessID + i;
+        record.arrived = true;
+        record.metrics.arrivalTime = now;
+    }
+    arrivedProcesses_ += count;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @param  The current simulated time.
+    @post   The process is counted as switched onto the CPU. Its first run time is set if it never ran before.
+*/
+void SchedulingStats::recordDispatch(const int& processID, const unsigned long long& now)
+{
+    Record* record = findRecord(processID);
+    if (record == nullptr)
+        return;
+
+    if (!record->metrics.hasRun)
+    {
+        record->metrics.hasRun = true;
+        record->metrics.firstRunTime = now;
+        responseTime_.record(now - record->metrics.arrivalTime);
+    }
+    record->metrics.contextSwitches++;
+    totalContextSwitches_++;
+}
+
+/*
+    @param  A const lvalue reference to a process ID that has already run.
+    @param  The number of times the process was switched onto the CPU.
+    @post   The context switches of the process are increased by the count.
+*/
+void SchedulingStats::recordDispatches(const int& processID, const unsigned long long& count)
+{
+    Record* record = findRecord(processID);
+    if (record == nullptr)
+        return;
+
+    record->metrics.contextSwitches += count;
+    totalContextSwitches_ += count;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @param  The number of time slices the process used.
+    @param  The CPU time those time slices amount to.
+    @post   The CPU usage of the process is increased.
+*/
+void SchedulingStats::recordQuanta(const int& processID, const unsigned long long& quanta, const unsigned long long& cpuTime)
+{
+    Record* record = findRecord(processID);
+    if (record == nullptr)
+        return;
+
+    record->metrics.cpuQuanta += quanta;
+    record->metrics.cpuTime += cpuTime;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @param  The current simulated time.
+    @param  True if the process is waiting for a disk, false if it is waiting for a child.
+    @post   The process is marked as blocked from the current time.
+*/
+void SchedulingStats::recordBlocked(const int& processID, const unsigned long long& now, const bool& onDiskIO)
+{
+    Record* record = findRecord(processID);
+    if (record == nullptr || record->blocked)
+        return;
+
+    record->blocked = true;
+    record->blockedOnDiskIO = onDiskIO;
+    record->blockedSince = now;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @param  The current simulated time.
+    @post   The time since the process blocked is added to its I/O or child wait time.
+*/
+void SchedulingStats::recordUnblocked(const int& processID, const unsigned long long& now)
+{
+    Record* record = findRecord(processID);
+    if (record == nullptr || !record->blocked)
+        return;
+
+    if (record->blockedOnDiskIO)
+        record->metrics.ioWaitTime += now - record->blockedSince;
+    else
+        record->metrics.childWaitTime += now - record->blockedSince;
+    record->blocked = false;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @param  A const lvalue reference to whether the access had to load its page.
+    @post   The access, and the page fault if there was one, are counted for the process.
+*/
+void SchedulingStats::recordMemoryAccess(const int& processID, const bool& pageFault)
+{
+    Record* record = findRecord(processID);
+    if (record == nullptr)
+        return;
+
+    record->metrics.memoryAccesses++;
+    if (pageFault)
+        record->metrics.pageFaults++;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @param  The current simulated time.
+    @post   The process is marked as completed and its turnaround, waiting time and context switches are added to the distributions.
+*/
+void SchedulingStats::recordCompletion(const int& processID, const unsigned long long& now)
+{
+    Record* record = findRecord(processID);
+    if (record == nullptr || record->metrics.hasCompleted)
+        return;
+
+    recordUnblocked(processID, now);
+    record->metrics.readyWaitTime = readyWaitTime(*record, now);
+    record->metrics.hasCompleted = true;
+    record->metrics.completionTime = now;
+
+    turnaroundTime_.record(now - record->metrics.arrivalTime);
+    waitingTime_.record(record->metrics.readyWaitTime);
+    contextSwitches_.record(record->metrics.contextSwitches);
+    completedProcesses_++;
+}
+
+/*
+    @param  A const lvalue reference to a process ID.
+    @return A pointer to the record of the process, or nullptr if its arrival was never recorded.
+*/
+SchedulingStats::Record* SchedulingStats::findRecord(const int& processID)
+{
+    if (!hasProcess(processID))
+        return nullptr;
+    return &records_[getProcessSlot(processID)];
+}
+
+/*
+    @param  A const lvalue reference to a record.
+    @param  The current simulated time.
+    @return The time the process spent neither running nor blocked since it arrived.
+            Live processes are measured up to the current time, completed ones up to their completion.
+*/
+unsigned long long SchedulingStats::readyWaitTime(const Record& record, const unsigned long long& now)
+{
+    const ProcessMetrics& metrics = record.metrics;
+    if (metrics.hasCompleted)
+        return metrics.readyWaitTime;
+
+    unsigned long long lifetime = now - metrics.arrivalTime;
+    unsigned long long accountedFor = metrics.cpuTime + metrics.ioWaitTime + metrics.childWaitTime;
+    if (record.blocked)
+        accountedFor += now - record.blockedSince;
+    return lifetime > accountedFor ? lifetime - accountedFor : 0;
+}
+
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The per-process records, the counters and the histograms are appended to the checkpoint.
+*/
+void SchedulingStats::writeCheckpoint(CheckpointWriter& writer) const
+{
+    records_.writeCheckpoint(writer);
+    writer.write(arrivedProcesses_);
+    writer.write(completedProcesses_);
+    writer.write(totalContextSwitches_);
+    turnaroundTime_.writeCheckpoint(writer);
+    waitingTime_.writeCheckpoint(writer);
+    responseTime_.writeCheckpoint(writer);
+    contextSwitches_.writeCheckpoint(writer);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The statistics are the ones that were kept when the checkpoint was written.
+*/
+void SchedulingStats::readCheckpoint(CheckpointReader& reader)
+{
+    records_.readCheckpoint(reader);
+    arrivedProcesses_ = reader.read<unsigned long long>();
+    completedProcesses_ = reader.read<unsigned long long>();
+    totalContextSwitches_ = reader.read<unsigned long long>();
+    turnaroundTime_.readCheckpoint(reader);
+    waitingTime_.readCheckpoint(reader);
+    responseTime_.readCheckpoint(reader);
+    contextSwitches_.readCheckpoint(reader);
+}
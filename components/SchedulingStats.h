@@ -0,0 +1,92 @@
+// Alan Tuecci
+#ifndef SCHEDULINGSTATS_H
+#define SCHEDULINGSTATS_H
+#include <vector>
+#include <stdexcept>
+#include "Process.h"
+#include "Histogram.h"
+#include "Checkpoint.h"
+#include "CopyOnWrite.h"
+
+struct ProcessMetrics
+{
+    unsigned long long arrivalTime{0};      //Time the process was created
+    unsigned long long firstRunTime{0};     //Time the process was first given the CPU (valid once hasRun is set)
+    unsigned long long completionTime{0};   //Time the process exited or was terminated (valid once hasCompleted is set)
+    unsigned long long readyWaitTime{0};    //Time spent runnable but not running
+    unsigned long long cpuQuanta{0};        //Number of time slices the process ran to the end of
+    unsigned long long cpuTime{0};          //Time spent using the CPU
+    unsigned long long ioWaitTime{0};       //Time spent blocked on disk I/O
+    unsigned long long childWaitTime{0};    //Time spent blocked in SimWait(), on a message queue, or asleep between real-time jobs
+    unsigned long long contextSwitches{0};  //Number of times the process was switched onto the CPU
+    unsigned long long memoryAccesses{0};   //Memory accesses made while running
+    unsigned long long pageFaults{0};       //Memory accesses that had to load their page into a frame
+    bool hasRun{false};
+    bool hasCompleted{false};
+};
+
+struct SchedulingSummary
+{
+    unsigned long long arrivedProcesses{0};
+    unsigned long long completedProcesses{0};
+    unsigned long long totalContextSwitches{0};
+    PercentileSummary turnaroundTime;   //Completion time minus arrival time of completed processes
+    PercentileSummary waitingTime;      //Ready-queue wait of completed processes
+    PercentileSummary responseTime;     //First run time minus arrival time of processes that have run
+    PercentileSummary contextSwitches;  //Context switches per completed process
+};
+
+/*
+    Per-process scheduling metrics. Threads are scheduled on their own, so they have records and are counted like processes.
+    Every record operation is constant-time; distributions are kept in histograms so summaries don't depend on the number of processes.
+    Records are kept per process table slot, so a recycled slot reuses the record of the process that had it before.
+*/
+class SchedulingStats
+{
+public:
+    //Constructors
+    SchedulingStats();
+
+    //Getters
+    bool hasProcess(const int& processID) const;
+    ProcessMetrics getProcessMetrics(const int& processID, const unsigned long long& now) const;
+    SchedulingSummary getSummary() const;
+
+    //Utilities
+    void recordArrival(const int& processID, const unsigned long long& now);
+    void recordArrivals(const int& firstProcessID, const unsigned int& count, const unsigned long long& now);
+    void recordDispatch(const int& processID, const unsigned long long& now);
+    void recordDispatches(const int& processID, const unsigned long long& count);
+    void recordQuanta(const int& processID, const unsigned long long& quanta, const unsigned long long& cpuTime);
+    void recordBlocked(const int& processID, const unsigned long long& now, const bool& onDiskIO);
+    void recordUnblocked(const int& processID, const unsigned long long& now);
+    void recordMemoryAccess(const int& processID, const bool& pageFault);
+    void recordCompletion(const int& processID, const unsigned long long& now);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    struct Record
+    {
+        ProcessMetrics metrics;
+        int processID{NO_PROCESS};      //PID of the process the record belongs to
+        unsigned long long blockedSince{0};
+        bool arrived{false};
+        bool blocked{false};
+        bool blockedOnDiskIO{false};
+    };
+
+    Record* findRecord(const int& processID);
+    static unsigned long long readyWaitTime(const Record& record, const unsigned long long& now);
+
+    ChunkedVector<Record, 8> records_;  //Indexed by process table slot; copies share the chunks they don't change
+    unsigned long long arrivedProcesses_;
+    unsigned long long completedProcesses_;
+    unsigned long long totalContextSwitches_;
+    Histogram turnaroundTime_;
+    Histogram waitingTime_;
+    Histogram responseTime_;
+    Histogram contextSwitches_;
+};
+#endif
@@ -0,0 +1,205 @@
+// Alan Tuecci
+#include "Volume.h"
+
+//--------------------------------------------Constructors--------------------------------------------
+
+/*
+    @post   Volume object initialized as a RAID-0 volume without disks.
+*/
+Volume::Volume() : Volume(RAID0, std::vector<int>{})
+{
+}
+
+/*
+    @param  A const lvalue reference to the RAID level, RAID0, RAID1 or RAID5.
+    @param  A const lvalue reference to the numbers of the distinct disks the volume is made of, enough of them for the level.
+    @post   A volume with no failed disks and no pending reads. The caller checks the level and the disks.
+*/
+Volume::Volume(const int& level, const std::vector<int>& disks) :
+    level_{level},
+    disks_{disks},
+    failed_(disks.size(), 0),
+    pending_{},
+    stats_{},
+    responseTime_{}
+{
+    stats_.level = level;
+    stats_.disks = static_cast<unsigned int>(disks.size());
+}
+
+//--------------------------------------------Getters--------------------------------------------
+
+/*
+    @return The RAID level of the volume.
+*/
+int Volume::getLevel() const
+{
+    return level_;
+}
+
+/*
+    @return The number of blocks the volume holds: a block per cylinder of every disk for RAID-0, of one disk for RAID-1,
+            and of all disks but one for RAID-5, whose remaining cylinders hold parity.
+*/
+unsigned long long Volume::getCapacity() const
+{
+    if (disks_.empty())
+        return 0;
+    else if (level_ == RAID1)
+        return DEFAULT_DISK_CYLINDERS;
+    else if (level_ == RAID5)
+        return (disks_.size() - 1) * DEFAULT_DISK_CYLINDERS;
+    return disks_.size() * DEFAULT_DISK_CYLINDERS;
+}
+
+/*
+    @return The number of disks in the volume.
+*/
+unsigned int Volume::getDiskCount() const
+{
+    return static_cast<unsigned int>(disks_.size());
+}
+
+/*
+    @param  A const lvalue reference to the index of a disk in the volume.
+    @return True if every block can still be read once the disk fails: RAID-1 needs one working copy, RAID-5 survives one failed disk, and RAID-0 none.
+*/
+bool Volume::canFailDisk(const unsigned int& member) const
+{
+    if (failed_[member])
+        return true;
+    else if (level_ == RAID1)
+        return failedCount() + 1 < disks_.size();
+    else if (level_ == RAID5)
+        return failedCount() == 0;
+    return false;
+}
+
+/*
+    @param  A const lvalue reference to a PID.
+    @return True if the process is waiting for sub-requests of a read from this volume.
+*/
+bool Volume::isPending(const int& PID) const
+{
+    return !pending_.empty() && pending_.count(PID) != 0;
+}
+
+/*
+    @return The reads of the volume, the sub-requests they were split into, and the distribution of their response times.
+*/
+VolumeStats Volume::getStats() const
+{
+    VolumeStats stats = stats_;
+    stats.failedDisks = failedCount();
+    stats.capacity = getCapacity();
+    stats.pendingReads = static_cast<unsigned int>(pending_.size());
+    stats.responseTime = responseTime_.getSummary();
+    return stats;
+}
+
+//--------------------------------------------Setters--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the index of a disk in the volume, one that canFailDisk() allows to fail.
+    @post   Reads no longer use the disk. Sub-requests already sent to it still complete.
+*/
+void Volume::setDiskFailed(const unsigned int& member)
+{
+    failed_[member] = 1;
+}
+
+//--------------------------------------------Utilities--------------------------------------------
+
+/*
+    @param  A const lvalue reference to the PID of the reading process.
+    @param  A const lvalue reference to the number of blocks read.
+    @param  A const lvalue reference to the number of sub-requests the read was split into, at least 1.
+    @param  A const lvalue reference to the simulated time of the read.
+    @post   The process waits until that many sub-requests complete.
+*/
+void Volume::startRead(const int& PID, const unsigned int& blockCount, const std::size_t& subrequests, const unsigned long long& arrivalTime)
+{
+    pending_[PID] = PendingRead{subrequests, arrivalTime};
+    stats_.reads++;
+    stats_.blocksRead += blockCount;
+    stats_.subrequests += subrequests;
+    stats_.reconstructionReads += subrequests - blockCount;
+}
+
+/*
+    @param  A const lvalue reference to the PID of a process with a pending read.
+    @param  A const lvalue reference to the current simulated time.
+    @post   One sub-request of the read is completed. When it is the last one, the read is done and its response time is recorded.
+    @return True if the read is done and the process can be woken.
+*/
+bool Volume::finishSubrequest(const int& PID, const unsigned long long& currentTime)
+{
+    std::unordered_map<int, PendingRead>::iterator read = pending_.find(PID);
+    if (--read->second.remaining != 0)
+        return false;
+    responseTime_.record(currentTime > read->second.arrivalTime ? currentTime - read->second.arrivalTime : 0);
+    pending_.erase(read);
+    return true;
+}
+
+/*
+    @return The number of failed disks.
+*/
+unsigned int Volume::failedCount() const
+{
+    return static_cast<unsigned int>(std::count(failed_.begin(), failed_.end(), 1));
+}
+
+//--------------------------------------------Checkpoints--------------------------------------------
+
+/*
+    @param  A reference to the checkpoint being written.
+    @post   The level, the disks and which of them failed, the pending reads and the statistics are appended to the checkpoint.
+*/
+void Volume::writeCheckpoint(CheckpointWriter& writer) const
+{
+    writer.write(level_);
+    writer.writeArray(disks_);
+    writer.writeArray(failed_);
+
+    std::vector<int> readers;
+    std::vector<PendingRead> reads;
+    for (const std::pair<const int, PendingRead>& read : pending_)
+    {
+        readers.push_back(read.first);
+        reads.push_back(read.second);
+    }
+    writer.writeArray(readers);
+    writer.writeArray(reads);
+
+    writer.write(stats_);
+    responseTime_.writeCheckpoint(writer);
+}
+
+/*
+    @param  A reference to the checkpoint being read.
+    @post   The volume is in the state it was in when the checkpoint was written.
+
+    @note   If the disks and their failures or the pending reads don't add up, throw std::runtime_error exception.
+*/
+void Volume::readCheckpoint(CheckpointReader& reader)
+{
+    level_ = reader.read<int>();
+    reader.readArray(disks_);
+    reader.readArray(failed_);
+    if (disks_.size() != failed_.size())
+        throw std::runtime_error("The checkpoint has a corrupt volume");
+
+    std::vector<int> readers;
+    std::vector<PendingRead> reads;
+    reader.readArray(readers);
+    reader.readArray(reads);
+    if (readers.size() != reads.size())
+        throw std::runtime_error("The checkpoint has a corrupt volume");
+    pending_.clear();
+    for (std::size_t i = 0; i < readers.size(); i++)
+        pending_[readers[i]] = reads[i];
+
+    stats_ = reader.read<VolumeStats>();
+    responseTime_.readCheckpoint(reader);
+}
@@ -0,0 +1,161 @@
+// Alan Tuecci
+#ifndef VOLUME_H
+#define VOLUME_H
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include "Process.h"
+#include "DiskManager.h"
+#include "Histogram.h"
+#include "Checkpoint.h"
+
+constexpr int RAID0{0};     //Blocks are striped across the disks, with no redundancy
+constexpr int RAID1{1};     //Every disk holds a copy of every block; a read goes to the least busy copy
+constexpr int RAID5{5};     //Blocks are striped across all but one disk of each row, and the remaining disk holds the row's parity
+
+//Location of one sub-request of a volume read
+struct VolumeBlock
+{
+    int diskNumber{0};
+    unsigned long long cylinder{0};
+};
+
+struct VolumeStats
+{
+    int level{RAID0};
+    unsigned int disks{0};
+    unsigned int failedDisks{0};
+    unsigned long long capacity{0};             //Blocks the volume holds
+    unsigned long long reads{0};
+    unsigned long long blocksRead{0};
+    unsigned long long subrequests{0};          //Disk requests the reads were split into
+    unsigned long long reconstructionReads{0};  //Extra disk requests a degraded RAID-5 made to rebuild blocks of a failed disk from parity
+    unsigned int pendingReads{0};               //Reads waiting for some of their sub-requests
+    PercentileSummary responseTime;             //From the read to the completion of its last sub-request
+};
+
+/*
+    A RAID volume over some of the simulation's disks. A logical read of a range of blocks is split into one sub-request per block,
+    on the disk and cylinder the RAID level puts the block on, and the volume counts the sub-requests of each reading process
+    so the process is woken only when the last one completes.
+*/
+class Volume
+{
+public:
+    //Constructors
+    Volume();
+    Volume(const int& level, const std::vector<int>& disks);
+
+    //Getters
+    int getLevel() const;
+    unsigned long long getCapacity() const;
+    unsigned int getDiskCount() const;
+    bool canFailDisk(const unsigned int& member) const;
+    bool isPending(const int& PID) const;
+    VolumeStats getStats() const;
+
+    //Setters
+    void setDiskFailed(const unsigned int& member);
+
+    //Utilities
+    template <class QueueDepth>
+    std::vector<VolumeBlock> mapRead(const unsigned long long& block, const unsigned int& blockCount, const QueueDepth& queueDepthOf) const;
+    void startRead(const int& PID, const unsigned int& blockCount, const std::size_t& subrequests, const unsigned long long& arrivalTime);
+    bool finishSubrequest(const int& PID, const unsigned long long& currentTime);
+    template <class Predicate>
+    void removeProcesses(const Predicate& shouldRemove);
+
+    //Checkpoints
+    void writeCheckpoint(CheckpointWriter& writer) const;
+    void readCheckpoint(CheckpointReader& reader);
+private:
+    struct PendingRead
+    {
+        unsigned long long remaining{0};    //Sub-requests that haven't completed
+        unsigned long long arrivalTime{0};
+    };
+
+    unsigned int failedCount() const;
+
+    int level_;
+    std::vector<int> disks_;                //Disk number of each member
+    std::vector<unsigned char> failed_;     //1 for each member that failed
+    std::unordered_map<int, PendingRead> pending_;
+
+    VolumeStats stats_;
+    Histogram responseTime_;
+};
+
+/*
+    @param  A const lvalue reference to the first block of the read.
+    @param  A const lvalue reference to the number of blocks, so that block + blockCount is at most the capacity.
+    @param  A const lvalue reference to a function that takes a disk number and returns the number of requests at the disk.
+    @return The sub-requests of the read, one per block in block order. A RAID-1 block goes to the copy with the fewest requests, counting the ones
+            this read already sent. A RAID-5 block of a failed disk is rebuilt from the other disks of its row, so it takes one sub-request on each of them.
+*/
+template <class QueueDepth>
+std::vector<VolumeBlock> Volume::mapRead(const unsigned long long& block, const unsigned int& blockCount, const QueueDepth& queueDepthOf) const
+{
+    std::vector<VolumeBlock> subrequests;
+    subrequests.reserve(blockCount);
+    const unsigned long long members = disks_.size();
+    std::vector<unsigned long long> load;
+    if (level_ == RAID1)
+    {
+        for (const int& diskNumber : disks_)
+            load.push_back(queueDepthOf(diskNumber));
+    }
+
+    for (unsigned long long logicalBlock = block; logicalBlock < block + blockCount; logicalBlock++)
+    {
+        if (level_ == RAID0)
+            subrequests.push_back(VolumeBlock{disks_[logicalBlock % members], logicalBlock / members});
+        else if (level_ == RAID1)
+        {
+            unsigned long long leastBusy = members;
+            for (unsigned long long member = 0; member < members; member++)
+            {
+                if (!failed_[member] && (leastBusy == members || load[member] < load[leastBusy]))
+                    leastBusy = member;
+            }
+            load[leastBusy]++;
+            subrequests.push_back(VolumeBlock{disks_[leastBusy], logicalBlock});
+        }
+        else
+        {
+            unsigned long long row = logicalBlock / (members - 1);
+            unsigned long long parity = members - 1 - row % members;    //Parity rotates across the disks, so no disk is a parity bottleneck
+            unsigned long long member = logicalBlock % (members - 1);
+            if (member >= parity)
+                member++;
+            if (!failed_[member])
+                subrequests.push_back(VolumeBlock{disks_[member], row});
+            else
+            {
+                for (unsigned long long survivor = 0; survivor < members; survivor++)
+                {
+                    if (survivor != member)
+                        subrequests.push_back(VolumeBlock{disks_[survivor], row});
+                }
+            }
+        }
+    }
+    return subrequests;
+}
+
+/*
+    @param  A const lvalue reference to a function that takes a PID and returns true if the process is gone.
+    @post   The pending reads of such processes are dropped. Their sub-requests still complete, but wake no one.
+*/
+template <class Predicate>
+void Volume::removeProcesses(const Predicate& shouldRemove)
+{
+    for (std::unordered_map<int, PendingRead>::iterator i = pending_.begin(); i != pending_.end(); )
+    {
+        if (shouldRemove(i->first))
+            i = pending_.erase(i);
+        else
+            i++;
+    }
+}
+#endif
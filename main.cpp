@@ -8,6 +8,26 @@
 #include "./components/MemoryManager.cpp"
 #include "./components/Process.h"
 #include "./components/Process.cpp"
+#include "./components/ProcessTable.h"
+#include "./components/ProcessTable.cpp"
+#include "./components/Histogram.h"
+#include "./components/Histogram.cpp"
+#include "./components/SchedulingStats.h"
+#include "./components/SchedulingStats.cpp"
+#include "./components/EDFScheduler.h"
+#include "./components/EDFScheduler.cpp"
+#include "./components/Checkpoint.h"
+#include "./components/Checkpoint.cpp"
+#include "./components/MessageQueue.h"
+#include "./components/MessageQueue.cpp"
+#include "./components/FileNameTable.h"
+#include "./components/FileNameTable.cpp"
+#include "./components/Volume.h"
+#include "./components/Volume.cpp"
+#include "./components/ReplicaSet.h"
+#include "./components/ReplicaSet.cpp"
+#include "./components/FileSystem.h"
+#include "./components/FileSystem.cpp"
 #include <deque>
 #include <iostream>
 